@@ -0,0 +1,30 @@
+#ifndef APPLE_H
+#define APPLE_H
+
+#include "Position.h"
+#include "OccupancyGrid.h"
+#include "GameRandom.h"
+#include <cstdint>
+
+class Apple {
+private:
+    Position position;
+    GameRandom rng;
+
+public:
+    Apple() : position{ 0, 0 } {}
+
+    void seed(std::uint64_t gameSeed, std::uint64_t stream) {
+        rng.seed(gameSeed, stream);
+    }
+
+    // Draws from the grid's free-cell list, so this takes the same time on an
+    // empty board as on a nearly full one. Returns false when no cell is free.
+    bool respawn(const OccupancyGrid& occupied) {
+        return occupied.pickFreeCell(rng, position);
+    }
+
+    Position getPosition() const { return position; }
+};
+
+#endif // APPLE_H
@@ -0,0 +1,98 @@
+#ifndef ARENARENDERER_H
+#define ARENARENDERER_H
+
+#include <SFML/Graphics.hpp>
+#include "SnakeArena.h"
+#include "FrameStats.h"
+#include <cmath>
+
+// Draws the snakes and apples of a SnakeArena seen through a BoardCamera;
+// the checkerboard under them comes from CulledBoardRenderer. Like that
+// renderer it only looks at the visible cells, reading each one's owner from
+// the arena's grid, so the cost of a frame depends on the zoom and not on
+// how many snakes are out of sight. The players keep fixed colours and the
+// bots take one from a small palette by id; heads are drawn darker.
+class ArenaRenderer {
+private:
+    static const size_t circleSegments = 8;
+    static const int botColorCount = 6;
+
+    sf::VertexArray entities;
+    float cellSize;
+    sf::Vector2f unitCircle[circleSegments];
+    sf::Color botColors[botColorCount];
+
+    void addQuad(const sf::Vector2f& topLeft, float size, const sf::Color& color) {
+        sf::Vector2f topRight(topLeft.x + size, topLeft.y);
+        sf::Vector2f bottomRight(topLeft.x + size, topLeft.y + size);
+        sf::Vector2f bottomLeft(topLeft.x, topLeft.y + size);
+        entities.append(sf::Vertex(topLeft, color));
+        entities.append(sf::Vertex(topRight, color));
+        entities.append(sf::Vertex(bottomRight, color));
+        entities.append(sf::Vertex(topLeft, color));
+        entities.append(sf::Vertex(bottomRight, color));
+        entities.append(sf::Vertex(bottomLeft, color));
+    }
+
+    void addApple(int x, int y, const sf::Color& color) {
+        sf::Vector2f center((x + 0.5f) * cellSize, (y + 0.5f) * cellSize);
+        float radius = cellSize / 2 - 2;
+        for (size_t i = 0; i < circleSegments; ++i) {
+            size_t next = (i + 1) % circleSegments;
+            entities.append(sf::Vertex(center, color));
+            entities.append(sf::Vertex(center + unitCircle[i] * radius, color));
+            entities.append(sf::Vertex(center + unitCircle[next] * radius, color));
+        }
+    }
+
+    sf::Color colorOf(int id, int players) const {
+        if (id < players) return id == 0 ? sf::Color(65, 105, 225) : sf::Color(255, 140, 0);
+        return botColors[id % botColorCount];
+    }
+
+    static sf::Color darken(const sf::Color& color) {
+        return sf::Color(color.r / 2, color.g / 2, color.b / 2);
+    }
+
+public:
+    explicit ArenaRenderer(float cellSize) : entities(sf::Triangles), cellSize(cellSize) {
+        const float pi = 3.14159265f;
+        for (size_t i = 0; i < circleSegments; ++i) {
+            float angle = 2 * pi * i / circleSegments;
+            unitCircle[i] = sf::Vector2f(std::cos(angle), std::sin(angle));
+        }
+        botColors[0] = sf::Color(120, 200, 120);
+        botColors[1] = sf::Color(200, 200, 110);
+        botColors[2] = sf::Color(110, 190, 200);
+        botColors[3] = sf::Color(200, 130, 190);
+        botColors[4] = sf::Color(170, 170, 170);
+        botColors[5] = sf::Color(150, 120, 210);
+    }
+
+    // visible comes from BoardCamera::getVisibleCells
+    void update(const SnakeArena& arena, const sf::IntRect& visible, const sf::Color& appleColor) {
+        entities.clear();
+        int players = arena.getPlayerCount();
+        for (int y = visible.top; y < visible.top + visible.height; ++y) {
+            for (int x = visible.left; x < visible.left + visible.width; ++x) {
+                Position cell{ x, y };
+                std::uint16_t owner = arena.ownerAt(cell);
+                if (owner == SnakeArena::emptyCell) continue;
+                if (owner == SnakeArena::appleCell) {
+                    addApple(x, y, appleColor);
+                    continue;
+                }
+                int id = owner - 1;
+                sf::Color color = colorOf(id, players);
+                if (arena.getHead(id) == cell) color = darken(color);
+                addQuad(sf::Vector2f(x * cellSize + 1, y * cellSize + 1), cellSize - 2, color);
+            }
+        }
+    }
+
+    void draw(sf::RenderTarget& target, FrameStats& stats) {
+        stats.draw(target, entities);
+    }
+};
+
+#endif // ARENARENDERER_H
\ No newline at end of file
@@ -0,0 +1,247 @@
+#ifndef ASSETCACHE_H
+#define ASSETCACHE_H
+
+#include <SFML/Graphics.hpp>
+#include "AssetPack.h"
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Loads each font and texture once and hands out shared references to it,
+// so every menu drawing with the same font uses the same sf::Font. Entries
+// are reference counted: the cache only holds weak references, and an
+// asset is freed when the last menu using it goes away.
+//
+// Fonts are asked for by a family name with a list of candidate files, of
+// which the first that loads wins. The winner is remembered per family in a
+// small index file, so later launches try it first and skip the probing
+// (and the error output of every failed path) entirely.
+//
+// Loading happens on a background thread so the window can draw from the
+// first frame: fonts are parsed and images decoded to sf::Image there, and
+// update(), called once per frame on the render thread, uploads finished
+// images to textures and passes every result to the callbacks that asked
+// for it. A callback gets null if nothing could be loaded.
+//
+// If an asset pack (see AssetPack.h) sits next to the game, it is mapped
+// once and files found in it are loaded straight from the mapping; only
+// what the pack lacks is looked for on disk. The cache must outlive the
+// fonts it hands out, which read from the mapping for as long as they live.
+class AssetCache {
+public:
+    typedef std::function<void(std::shared_ptr<const sf::Font>)> FontCallback;
+    typedef std::function<void(std::shared_ptr<const sf::Texture>)> TextureCallback;
+
+private:
+    // One file or family in flight. The loader thread only writes the
+    // result fields; the callbacks belong to the render thread.
+    struct Job {
+        bool isFont;
+        std::string key;                // Family or texture path
+        std::vector<std::string> paths; // Tried in order
+        std::shared_ptr<sf::Font> font;
+        sf::Image image;
+        std::string loadedPath;         // Empty if nothing loaded
+        std::vector<FontCallback> fontCallbacks;
+        std::vector<TextureCallback> textureCallbacks;
+    };
+
+    AssetPack pack; // First member, so it is unmapped last
+    std::string indexPath;
+    std::map<std::string, std::string> resolved; // Family -> path that loaded
+    std::map<std::string, std::weak_ptr<sf::Font>> fonts;       // By path
+    std::map<std::string, std::weak_ptr<sf::Texture>> textures; // By path
+    std::map<std::string, std::shared_ptr<Job>> inFlight;      // By kind and key
+    unsigned requested;
+    unsigned completed;
+
+    std::thread loader;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::deque<std::shared_ptr<Job>> queue; // Guarded by mutex
+    std::deque<std::shared_ptr<Job>> done;  // Guarded by mutex
+    bool stopping;                          // Guarded by mutex
+
+    void loadIndex() {
+        std::ifstream in(indexPath.c_str());
+        std::string line;
+        while (std::getline(in, line)) {
+            size_t tab = line.find('\t');
+            if (tab != std::string::npos) resolved[line.substr(0, tab)] = line.substr(tab + 1);
+        }
+    }
+
+    void saveIndex() const {
+        std::ofstream out(indexPath.c_str(), std::ios::trunc);
+        for (const auto& entry : resolved) {
+            out << entry.first << '\t' << entry.second << '\n';
+        }
+    }
+
+    // Loader thread. Packed candidates go first, so a family the pack
+    // covers never probes the disk for files that are not there.
+    void load(Job& job) const {
+        for (int fromPack = 1; fromPack >= 0; --fromPack) {
+            for (const auto& path : job.paths) {
+                const void* data = nullptr;
+                size_t size = 0;
+                bool packed = pack.find(path, data, size);
+                if (packed != (fromPack == 1)) continue;
+                if (job.isFont) {
+                    std::shared_ptr<sf::Font> font = std::make_shared<sf::Font>();
+                    if (!(packed ? font->loadFromMemory(data, size) : font->loadFromFile(path))) continue;
+                    job.font = font;
+                }
+                else if (!(packed ? job.image.loadFromMemory(data, size) : job.image.loadFromFile(path))) {
+                    continue;
+                }
+                job.loadedPath = path;
+                return;
+            }
+        }
+    }
+
+    void run() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            wake.wait(lock, [this]() { return stopping || !queue.empty(); });
+            if (stopping) return;
+            std::shared_ptr<Job> job = queue.front();
+            queue.pop_front();
+            lock.unlock();
+            load(*job);
+            lock.lock();
+            done.push_back(job);
+        }
+    }
+
+    void enqueue(const std::shared_ptr<Job>& job) {
+        ++requested;
+        inFlight[(job->isFont ? "font:" : "texture:") + job->key] = job;
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!loader.joinable()) loader = std::thread(&AssetCache::run, this);
+        queue.push_back(job);
+        wake.notify_one();
+    }
+
+    void finish(Job& job) {
+        ++completed;
+        inFlight.erase((job.isFont ? "font:" : "texture:") + job.key);
+        if (job.isFont) {
+            std::shared_ptr<sf::Font> font;
+            if (!job.loadedPath.empty()) {
+                // Another family may have loaded the same file meanwhile
+                font = fonts[job.loadedPath].lock();
+                if (!font) {
+                    font = job.font;
+                    fonts[job.loadedPath] = font;
+                }
+                if (resolved[job.key] != job.loadedPath) {
+                    resolved[job.key] = job.loadedPath;
+                    saveIndex();
+                }
+            }
+            for (const auto& callback : job.fontCallbacks) callback(font);
+        }
+        else {
+            std::shared_ptr<sf::Texture> texture;
+            if (!job.loadedPath.empty()) {
+                texture = std::make_shared<sf::Texture>();
+                if (texture->loadFromImage(job.image)) textures[job.key] = texture;
+                else texture.reset();
+            }
+            for (const auto& callback : job.textureCallbacks) callback(texture);
+        }
+    }
+
+public:
+    explicit AssetCache(const std::string& indexPath = "asset_paths.txt", const std::string& packPath = "assets.pak")
+        : indexPath(indexPath), requested(0), completed(0), stopping(false) {
+        pack.open(packPath);
+        loadIndex();
+    }
+
+    ~AssetCache() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_one();
+        if (loader.joinable()) loader.join();
+    }
+
+    AssetCache(const AssetCache&) = delete;
+    AssetCache& operator=(const AssetCache&) = delete;
+
+    // Loads the first of candidates that works, trying the path remembered
+    // for family from an earlier run before the list. Calls back at once if
+    // that font is already loaded, otherwise from a later update(). Until
+    // then the cache holds on to the callback, so whatever it captures must
+    // outlive the request and stay where it is: the menus pass this, and so
+    // cannot be copied. The same goes for requestTexture.
+    void requestFont(const std::string& family, const std::vector<std::string>& candidates, FontCallback callback) {
+        auto known = resolved.find(family);
+        if (known != resolved.end()) {
+            std::shared_ptr<sf::Font> font = fonts[known->second].lock();
+            if (font) {
+                callback(font);
+                return;
+            }
+        }
+        auto pending = inFlight.find("font:" + family);
+        if (pending != inFlight.end()) {
+            pending->second->fontCallbacks.push_back(callback);
+            return;
+        }
+        std::shared_ptr<Job> job = std::make_shared<Job>();
+        job->isFont = true;
+        job->key = family;
+        if (known != resolved.end()) job->paths.push_back(known->second);
+        job->paths.insert(job->paths.end(), candidates.begin(), candidates.end());
+        job->fontCallbacks.push_back(callback);
+        enqueue(job);
+    }
+
+    // The image is decoded off-thread and uploaded in a later update()
+    void requestTexture(const std::string& path, TextureCallback callback) {
+        std::shared_ptr<sf::Texture> texture = textures[path].lock();
+        if (texture) {
+            callback(texture);
+            return;
+        }
+        auto pending = inFlight.find("texture:" + path);
+        if (pending != inFlight.end()) {
+            pending->second->textureCallbacks.push_back(callback);
+            return;
+        }
+        std::shared_ptr<Job> job = std::make_shared<Job>();
+        job->isFont = false;
+        job->key = path;
+        job->paths.push_back(path);
+        job->textureCallbacks.push_back(callback);
+        enqueue(job);
+    }
+
+    // Render thread, once per frame: hands out whatever finished loading
+    void update() {
+        std::deque<std::shared_ptr<Job>> finished;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            finished.swap(done);
+        }
+        for (const auto& job : finished) finish(*job);
+    }
+
+    bool isLoading() const { return completed < requested; }
+    // Share of the requests made so far that have finished, 0 to 1
+    float getProgress() const { return requested == 0 ? 1.0f : static_cast<float>(completed) / requested; }
+};
+
+#endif // ASSETCACHE_H
\ No newline at end of file
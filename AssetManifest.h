@@ -0,0 +1,66 @@
+#ifndef ASSETMANIFEST_H
+#define ASSETMANIFEST_H
+
+#include <string>
+#include <vector>
+
+// Every font family and texture the game asks for, in one place so the
+// asset packer knows what to bundle. A family is a list of candidate files
+// tried in order; the packer keeps only the first one shipped with the game,
+// so the other fonts lying next to it are left out of the pack.
+namespace AssetManifest {
+    inline std::vector<std::string> fontFamilies() {
+        return { "menu", "pause", "game" };
+    }
+
+    inline std::vector<std::string> fontCandidates(const std::string& family) {
+        if (family == "menu") {
+            return {
+                "ARCADECLASSIC.ttf",
+                "fonts/KnightWarrior.ttf",
+                "assets/fonts/KnightWarrior.ttf",
+                "Bruce Forever.ttf",
+                "C:/Windows/Fonts/arial.ttf",
+                "/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf"
+            };
+        }
+        if (family == "pause") {
+            return {
+                "ARCADECLASSIC.ttf",
+                "fonts/KnightWarrior.ttf",
+                "assets/fonts/KnightWarrior.ttf",
+                "Bruce Forever.ttf",
+                "impact.ttf",
+                "bebas.ttf",
+                "orbitron.ttf",
+                "russo.ttf",
+                "C:/Windows/Fonts/arialbd.ttf",
+                "C:/Windows/Fonts/arial.ttf",
+                "/usr/share/fonts/truetype/liberation/LiberationSans-Bold.ttf",
+                "/usr/share/fonts/truetype/dejavu/DejaVuSans-Bold.ttf",
+                "/System/Library/Fonts/Arial.ttf",
+                "/Library/Fonts/Arial.ttf"
+            };
+        }
+        return {
+            "impact.ttf", // Prioritize ARCADECLASSIC.ttf
+            "bebas.ttf", "orbitron.ttf", "russo.ttf",
+            "arialbd.ttf", "arial.ttf",
+            "C:/Windows/Fonts/impact.ttf", "C:/Windows/Fonts/arialbd.ttf", "C:/Windows/Fonts/arial.ttf",
+            "/usr/share/fonts/truetype/liberation/LiberationSans-Bold.ttf",
+            "/usr/share/fonts/truetype/dejavu/DejaVuSans-Bold.ttf",
+            "/System/Library/Fonts/Arial.ttf", "/Library/Fonts/Arial.ttf"
+        };
+    }
+
+    inline std::vector<std::string> textures() {
+        return { "Snake Menu.jpg" };
+    }
+
+    // System fonts are used from where they are, never packed
+    inline bool isShipped(const std::string& path) {
+        return !path.empty() && path[0] != '/' && path.find(':') == std::string::npos;
+    }
+}
+
+#endif // ASSETMANIFEST_H
\ No newline at end of file
@@ -0,0 +1,164 @@
+#ifndef ASSETPACK_H
+#define ASSETPACK_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// All the game's assets in one file, written by the AssetPacker tool:
+//
+//   Header   magic "SNAKEPAK", version, entry count
+//   Entry[]  one per file, sorted by name
+//   data     each file starting on an 'alignment' byte boundary
+//
+// Integers are little endian. The reader maps the file read-only and looks
+// names up by binary search in the mapped table, so opening the pack reads
+// nothing up front and an asset is handed out as a pointer into the
+// mapping, ready for SFML's loadFromMemory without a copy. Fonts keep
+// reading from that memory, so the pack must outlive every font made from
+// it.
+class AssetPack {
+public:
+    static const std::uint32_t version = 1;
+    static const std::uint64_t alignment = 16;
+    static const size_t maxName = 112; // Including the terminating zero
+
+    struct Header {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t count;
+    };
+
+    struct Entry {
+        std::uint64_t offset; // From the start of the file
+        std::uint64_t size;
+        char name[maxName];
+    };
+
+private:
+    const unsigned char* data;
+    size_t size;
+    const Entry* entries;
+    std::uint32_t count;
+#ifdef _WIN32
+    HANDLE file;
+    HANDLE mapping;
+#endif
+
+    void unmap() {
+#ifdef _WIN32
+        if (data) UnmapViewOfFile(data);
+        if (mapping) CloseHandle(mapping);
+        if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+        file = INVALID_HANDLE_VALUE;
+        mapping = nullptr;
+#else
+        if (data) munmap(const_cast<unsigned char*>(data), size);
+#endif
+        data = nullptr;
+        size = 0;
+        entries = nullptr;
+        count = 0;
+    }
+
+    bool map(const std::string& path) {
+#ifdef _WIN32
+        file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) return false;
+        LARGE_INTEGER length;
+        if (!GetFileSizeEx(file, &length) || length.QuadPart == 0) return false;
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping) return false;
+        const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (!view) return false;
+        data = static_cast<const unsigned char*>(view);
+        size = static_cast<size_t>(length.QuadPart);
+#else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat info;
+        if (fstat(fd, &info) != 0 || info.st_size == 0) {
+            ::close(fd);
+            return false;
+        }
+        void* view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd); // The mapping keeps the file
+        if (view == MAP_FAILED) return false;
+        data = static_cast<const unsigned char*>(view);
+        size = static_cast<size_t>(info.st_size);
+#endif
+        return true;
+    }
+
+    // Rejects anything that would point outside the file
+    bool validate() {
+        if (size < sizeof(Header)) return false;
+        const Header* header = reinterpret_cast<const Header*>(data);
+        if (std::memcmp(header->magic, "SNAKEPAK", 8) != 0 || header->version != version) return false;
+        if (header->count > (size - sizeof(Header)) / sizeof(Entry)) return false;
+        const Entry* table = reinterpret_cast<const Entry*>(data + sizeof(Header));
+        for (std::uint32_t i = 0; i < header->count; ++i) {
+            if (table[i].name[maxName - 1] != '\0') return false;
+            if (table[i].offset > size || table[i].size > size - table[i].offset) return false;
+        }
+        entries = table;
+        count = header->count;
+        return true;
+    }
+
+    static bool nameLess(const Entry& entry, const std::string& name) {
+        return std::strcmp(entry.name, name.c_str()) < 0;
+    }
+
+public:
+#ifdef _WIN32
+    AssetPack() : data(nullptr), size(0), entries(nullptr), count(0), file(INVALID_HANDLE_VALUE), mapping(nullptr) {}
+#else
+    AssetPack() : data(nullptr), size(0), entries(nullptr), count(0) {}
+#endif
+
+    ~AssetPack() {
+        unmap();
+    }
+
+    AssetPack(const AssetPack&) = delete;
+    AssetPack& operator=(const AssetPack&) = delete;
+
+    // False if there is no pack or it is not one this build can read
+    bool open(const std::string& path) {
+        unmap();
+        if (map(path) && validate()) return true;
+        unmap();
+        return false;
+    }
+
+    bool isOpen() const { return entries != nullptr; }
+
+    // Safe to call from any thread once open() has returned
+    bool find(const std::string& name, const void*& fileData, size_t& fileSize) const {
+        const Entry* end = entries + count;
+        const Entry* entry = std::lower_bound(entries, end, name, nameLess);
+        if (entry == end || name != entry->name) return false;
+        fileData = data + entry->offset;
+        fileSize = static_cast<size_t>(entry->size);
+        return true;
+    }
+};
+
+#endif // ASSETPACK_H
\ No newline at end of file
@@ -0,0 +1,122 @@
+#include "AssetPack.h"
+#include "AssetManifest.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+// Builds the asset pack the game maps at startup. Run it from the folder
+// with the game's assets:
+//
+//   AssetPacker [output]   (default assets.pak)
+//
+// Each font family contributes only the first of its candidates found
+// here, which is the one the game would load, and every texture in the
+// manifest is packed as is. Fonts the game never picks are left out.
+
+namespace {
+    struct PackedFile {
+        std::string name;
+        std::vector<char> bytes;
+    };
+
+    bool readFile(const std::string& path, std::vector<char>& bytes) {
+        std::ifstream in(path.c_str(), std::ios::binary);
+        if (!in) return false;
+        bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        return true;
+    }
+
+    bool add(std::vector<PackedFile>& files, const std::string& name) {
+        for (const auto& file : files) {
+            if (file.name == name) return true;
+        }
+        if (name.size() >= AssetPack::maxName) {
+            std::fprintf(stderr, "Name too long for the pack: %s\n", name.c_str());
+            return false;
+        }
+        PackedFile file;
+        file.name = name;
+        if (!readFile(name, file.bytes)) return false;
+        files.push_back(file);
+        return true;
+    }
+
+    void pad(std::ofstream& out, std::uint64_t& position) {
+        while (position % AssetPack::alignment != 0) {
+            out.put('\0');
+            ++position;
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    std::string outputPath = argc > 1 ? argv[1] : "assets.pak";
+    std::vector<PackedFile> files;
+
+    for (const auto& family : AssetManifest::fontFamilies()) {
+        bool found = false;
+        for (const auto& candidate : AssetManifest::fontCandidates(family)) {
+            if (!AssetManifest::isShipped(candidate)) continue;
+            if (add(files, candidate)) {
+                std::printf("%-6s %s\n", family.c_str(), candidate.c_str());
+                found = true;
+                break;
+            }
+        }
+        if (!found) std::printf("%-6s (none shipped, the game will use a system font)\n", family.c_str());
+    }
+    for (const auto& texture : AssetManifest::textures()) {
+        if (!add(files, texture)) {
+            std::fprintf(stderr, "Missing texture: %s\n", texture.c_str());
+            return 1;
+        }
+        std::printf("%-6s %s\n", "image", texture.c_str());
+    }
+
+    // The reader binary searches the table, so it goes out sorted
+    std::sort(files.begin(), files.end(), [](const PackedFile& a, const PackedFile& b) {
+        return a.name < b.name;
+    });
+
+    AssetPack::Header header;
+    std::memcpy(header.magic, "SNAKEPAK", 8);
+    header.version = AssetPack::version;
+    header.count = static_cast<std::uint32_t>(files.size());
+
+    std::vector<AssetPack::Entry> entries(files.size());
+    std::uint64_t position = sizeof(header) + entries.size() * sizeof(AssetPack::Entry);
+    for (size_t i = 0; i < files.size(); ++i) {
+        position = (position + AssetPack::alignment - 1) / AssetPack::alignment * AssetPack::alignment;
+        std::memset(entries[i].name, 0, AssetPack::maxName);
+        std::memcpy(entries[i].name, files[i].name.c_str(), files[i].name.size());
+        entries[i].offset = position;
+        entries[i].size = files[i].bytes.size();
+        position += files[i].bytes.size();
+    }
+
+    std::ofstream out(outputPath.c_str(), std::ios::binary | std::ios::trunc);
+    if (!out) {
+        std::fprintf(stderr, "Cannot write %s\n", outputPath.c_str());
+        return 1;
+    }
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    if (!entries.empty()) {
+        out.write(reinterpret_cast<const char*>(&entries[0]), entries.size() * sizeof(AssetPack::Entry));
+    }
+    position = sizeof(header) + entries.size() * sizeof(AssetPack::Entry);
+    for (const auto& file : files) {
+        pad(out, position);
+        if (!file.bytes.empty()) out.write(&file.bytes[0], file.bytes.size());
+        position += file.bytes.size();
+    }
+    if (!out) {
+        std::fprintf(stderr, "Failed writing %s\n", outputPath.c_str());
+        return 1;
+    }
+    std::printf("Packed %u files, %llu bytes, into %s\n", header.count,
+        static_cast<unsigned long long>(position), outputPath.c_str());
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,401 @@
+#ifndef AUTOPILOT_H
+#define AUTOPILOT_H
+
+#include "GameSimulation.h"
+#include <vector>
+#include <climits>
+#include <algorithm>
+#include <cstdlib>
+
+// Plans paths with breadth-first search over the board.
+//
+// The search knows the body moves: the segment i cells behind the head
+// leaves its cell after length - i ticks, so a cell is only a wall if the
+// path reaches it before it empties. The bot takes the shortest path to the
+// nearest apple, but only if a snake that had followed that path and eaten
+// could still reach its own tail; otherwise it stalls along the longest way
+// back to its tail, and failing that takes the move with the most room.
+//
+// A plan is followed until it runs out, and only thrown away early when the
+// game changes under it: a blue apple turns up that could be nearer, the one
+// it was heading for goes, a bomb lands on the path, the walls close in, or
+// someone else steered. Following a plan is a few compares, so on big boards
+// a search runs about once per apple rather than once per tick. A blue apple
+// is only a target if the head gets there before it goes. While the apple is
+// unsafe the snake does not ask again every tick but after 1, 2, 4 and then
+// every 8 ticks, which is most of what the tail-following ticks used to cost.
+//
+// Circling the tail can go on forever when the apple never becomes safe.
+// If the snake goes longer without eating than it takes to go round its
+// body and cross the free cells twice, it stops asking for safety and takes
+// any path to the apple, so the game either moves on or ends.
+//
+// All buffers are sized to the board once and reused. Instead of clearing
+// them, each body snapshot and each search bumps a generation number and a
+// cell counts as stamped only if it carries the current one, so planning
+// allocates nothing and touches only the cells a search actually reaches.
+class Autopilot {
+private:
+    static const unsigned blocked = UINT_MAX;
+
+    int width;
+    int height;
+
+    std::vector<unsigned> freeAt;     // Ticks until the body leaves the cell
+    std::vector<unsigned> bodyStamp;  // Valid while equal to bodyGeneration
+    unsigned bodyGeneration;
+
+    std::vector<unsigned> visitStamp; // Visited while equal to visitGeneration
+    std::vector<unsigned> distance;   // Ticks from now when the search reached the cell
+    std::vector<unsigned char> rootMove;
+    std::vector<int> parent;
+    std::vector<int> queue;
+    std::vector<int> path;
+    unsigned visitGeneration;
+
+    // The plan being followed, first step first, and what the game looked
+    // like when it was made
+    std::vector<int> plan;
+    size_t planNext;
+    unsigned long long planTick; // Tick at which plan[planNext] is due
+    int planHead;
+    int planApple;
+    int planBlueApple;  // -1 when hidden
+    int planBomb;       // -1 when hidden
+    int planAppleCount;
+    unsigned planRevision;
+
+    unsigned long long lastTick;
+    unsigned long long lastMealTick;
+    int lastAppleCount;
+
+    // After the apple turns out unsafe the next try waits, twice as long
+    // each time up to maxRetryDelay, until the next meal
+    static const unsigned maxRetryDelay = 8;
+    unsigned long long retryTick;
+    unsigned retryDelay;
+
+    int cols;
+    int rows;
+    const OccupancyGrid* occupancy; // Of the game being planned; holds the level's walls
+
+    struct SearchResult {
+        int move;         // First move towards the target, or -1 if unreached
+        int target;       // Cell where the search stopped
+        unsigned length;  // Ticks from now to reach it
+        unsigned reached; // Cells visited
+    };
+
+    static int moveX(int move) { static const int dx[] = { 0, 0, -1, 1 }; return dx[move]; }
+    static int moveY(int move) { static const int dy[] = { -1, 1, 0, 0 }; return dy[move]; }
+
+    int indexOf(int x, int y) const { return y * width + x; }
+
+    bool passable(int x, int y, unsigned tick) const {
+        if (x < 0 || x >= cols || y < 0 || y >= rows) return false;
+        int index = indexOf(x, y);
+        if (bodyStamp[index] != bodyGeneration) return !occupancy->isObstacle(Position{ x, y });
+        return tick >= freeAt[index];
+    }
+
+    static void nextGeneration(unsigned& generation, std::vector<unsigned>& stamps) {
+        if (++generation == 0) {
+            std::fill(stamps.begin(), stamps.end(), 0u);
+            generation = 1;
+        }
+    }
+
+    void snapshotBody(const GameSimulation& sim) {
+        nextGeneration(bodyGeneration, bodyStamp);
+        const SnakeBody& body = sim.getSnake().getBody();
+        unsigned length = static_cast<unsigned>(body.size());
+        unsigned delay = sim.getSnake().isGrowing() ? 1 : 0;
+        // Tail first, so where Level 3 stacked segments the latest leaver wins
+        for (size_t i = body.size(); i-- > 0;) {
+            int index = indexOf(body[i].x, body[i].y);
+            freeAt[index] = length - static_cast<unsigned>(i) + delay;
+            bodyStamp[index] = bodyGeneration;
+        }
+        if (sim.isBombVisible()) {
+            int index = indexOf(sim.getBomb().x, sim.getBomb().y);
+            freeAt[index] = blocked;
+            bodyStamp[index] = bodyGeneration;
+        }
+    }
+
+    // Breadth-first from start, entered at startTick. Stops at the first cell
+    // for which isTarget holds, or once limit cells are visited; rootMove
+    // remembers which first step led there.
+    template <typename Target>
+    SearchResult search(const Position& start, unsigned startTick, int excludedMove, Target isTarget,
+        unsigned limit = UINT_MAX) {
+        nextGeneration(visitGeneration, visitStamp);
+        SearchResult result = { -1, -1, 0, 0 };
+        size_t head = 0, tail = 0;
+
+        int startIndex = indexOf(start.x, start.y);
+        visitStamp[startIndex] = visitGeneration;
+        for (int move = 0; move < 4; ++move) {
+            if (move == excludedMove) continue;
+            int x = start.x + moveX(move), y = start.y + moveY(move);
+            if (!passable(x, y, startTick + 1)) continue;
+            int index = indexOf(x, y);
+            if (visitStamp[index] == visitGeneration) continue;
+            visitStamp[index] = visitGeneration;
+            distance[index] = startTick + 1;
+            rootMove[index] = static_cast<unsigned char>(move);
+            parent[index] = startIndex;
+            queue[tail++] = index;
+        }
+
+        while (head < tail) {
+            int index = queue[head++];
+            if (++result.reached >= limit) return result;
+            if (isTarget(index)) {
+                result.move = rootMove[index];
+                result.target = index;
+                result.length = distance[index];
+                return result;
+            }
+            int x = index % width, y = index / width;
+            unsigned tick = distance[index] + 1;
+            for (int move = 0; move < 4; ++move) {
+                int nx = x + moveX(move), ny = y + moveY(move);
+                if (!passable(nx, ny, tick)) continue;
+                int next = indexOf(nx, ny);
+                if (visitStamp[next] == visitGeneration) continue;
+                visitStamp[next] = visitGeneration;
+                distance[next] = tick;
+                rootMove[next] = rootMove[index];
+                parent[next] = index;
+                queue[tail++] = next;
+            }
+        }
+        return result;
+    }
+
+    // Re-stamps the body as it would be right after following the last
+    // search's path to target and eating there, then checks that the new head
+    // can still get to the new tail. Leaves the body snapshot overwritten.
+    bool safeAfterEating(const GameSimulation& sim, int target, int headIndex) {
+        size_t steps = 0;
+        for (int index = target; index != headIndex; index = parent[index]) {
+            path[steps++] = index; // Newest first
+        }
+
+        // Growth still pending from the last meal puts one more segment
+        // behind the path; steps is at least one, so that segment exists
+        const SnakeBody& body = sim.getSnake().getBody();
+        size_t length = body.size() + (sim.getSnake().isGrowing() ? 1 : 0);
+        nextGeneration(bodyGeneration, bodyStamp);
+        int virtualTail = -1;
+        // Tail first again; each segment also waits for the pending growth
+        for (size_t j = length; j-- > 0;) {
+            int index = j < steps ? path[j] : indexOf(body[j - steps].x, body[j - steps].y);
+            if (virtualTail < 0) virtualTail = index;
+            freeAt[index] = static_cast<unsigned>(length - j + 1);
+            bodyStamp[index] = bodyGeneration;
+        }
+        if (sim.isBombVisible()) {
+            int index = indexOf(sim.getBomb().x, sim.getBomb().y);
+            freeAt[index] = blocked;
+            bodyStamp[index] = bodyGeneration;
+        }
+        Position start{ target % width, target / width };
+        return search(start, 0, -1, [virtualTail](int index) { return index == virtualTail; }).move >= 0;
+    }
+
+    // Appends the cells from last back along parent[] to stop, excluded, to
+    // the plan in walking order
+    void tracePlan(int last, int stop) {
+        size_t from = plan.size();
+        for (int index = last; index != stop; index = parent[index]) plan.push_back(index);
+        std::reverse(plan.begin() + from, plan.end());
+    }
+
+    // Records the game the plan was made for; its first step is taken now
+    void keepPlan(const GameSimulation& sim) {
+        planNext = 1;
+        planTick = sim.getTicks() + 1;
+        planHead = plan.front();
+        planApple = indexOf(sim.getApple().x, sim.getApple().y);
+        planBlueApple = sim.isBlueAppleVisible() ? indexOf(sim.getBlueApple().x, sim.getBlueApple().y) : -1;
+        planBomb = sim.isBombVisible() ? indexOf(sim.getBomb().x, sim.getBomb().y) : -1;
+        planAppleCount = sim.getAppleCount();
+        planRevision = sim.getBoardRevision();
+    }
+
+    // Next step of the plan if the game is still the one it was made for,
+    // or -1. A blue apple or bomb that turns up only matters if it could be
+    // nearer than the plan's apple or sits on the rest of the path.
+    int plannedMove(const GameSimulation& sim, int headIndex) {
+        if (planNext >= plan.size() || sim.getTicks() != planTick || headIndex != planHead ||
+            sim.getAppleCount() != planAppleCount || sim.getBoardRevision() != planRevision ||
+            indexOf(sim.getApple().x, sim.getApple().y) != planApple) return -1;
+        size_t remaining = plan.size() - planNext;
+        int blueApple = sim.isBlueAppleVisible() ? indexOf(sim.getBlueApple().x, sim.getBlueApple().y) : -1;
+        if (blueApple != planBlueApple) {
+            if (planBlueApple >= 0 && plan.back() == planBlueApple) return -1;
+            if (blueApple >= 0) {
+                size_t away = std::abs(blueApple % width - headIndex % width) + std::abs(blueApple / width - headIndex / width);
+                if (away < remaining && away <= sim.getBlueAppleMovesLeft()) return -1;
+            }
+            planBlueApple = blueApple;
+        }
+        int bomb = sim.isBombVisible() ? indexOf(sim.getBomb().x, sim.getBomb().y) : -1;
+        if (bomb != planBomb) {
+            if (bomb >= 0 && std::find(plan.begin() + planNext, plan.end(), bomb) != plan.end()) return -1;
+            planBomb = bomb;
+        }
+        int next = plan[planNext];
+        for (int move = 0; move < 4; ++move) {
+            if (indexOf(headIndex % width + moveX(move), headIndex / width + moveY(move)) == next) return move;
+        }
+        return -1;
+    }
+
+    int reverseOf(const Position& direction) const {
+        for (int move = 0; move < 4; ++move) {
+            if (moveX(move) == -direction.x && moveY(move) == -direction.y) return move;
+        }
+        return -1;
+    }
+
+public:
+    Autopilot()
+        : width(0), height(0), bodyGeneration(0), visitGeneration(0), planNext(0), planTick(0), planHead(-1),
+          planApple(-1), planBlueApple(-1), planBomb(-1), planAppleCount(0), planRevision(0),
+          lastTick(0), lastMealTick(0), lastAppleCount(0), retryTick(0), retryDelay(1), cols(0), rows(0), occupancy(nullptr) {}
+
+    // Sizes the buffers for a board; only allocates when the board is bigger
+    // than any seen before
+    void prepare(int boardCols, int boardRows) {
+        if (boardCols <= width && boardRows <= height) return;
+        width = std::max(width, boardCols);
+        height = std::max(height, boardRows);
+        size_t cells = static_cast<size_t>(width) * height;
+        freeAt.assign(cells, 0);
+        bodyStamp.assign(cells, 0);
+        visitStamp.assign(cells, 0);
+        distance.assign(cells, 0);
+        rootMove.assign(cells, 0);
+        parent.assign(cells, 0);
+        queue.assign(cells, 0);
+        path.assign(cells, 0);
+        plan.reserve(cells + 1);
+        plan.clear();
+        bodyGeneration = visitGeneration = 0;
+    }
+
+    GameSimulation::Action choose(const GameSimulation& sim) {
+        static const GameSimulation::Action actions[] = {
+            GameSimulation::Action::Up, GameSimulation::Action::Down,
+            GameSimulation::Action::Left, GameSimulation::Action::Right
+        };
+        cols = sim.getCols();
+        rows = sim.getRows();
+        occupancy = &sim.getSnake().getOccupancy();
+        prepare(cols, rows);
+
+        const Snake& snake = sim.getSnake();
+        Position head = snake.getHead();
+        int headIndex = indexOf(head.x, head.y);
+        unsigned length = static_cast<unsigned>(snake.getBody().size());
+
+        // A new game, a gap in the ticks or a meal all restart the count
+        if (sim.getTicks() != lastTick + 1 || sim.getAppleCount() != lastAppleCount) {
+            lastMealTick = sim.getTicks();
+            retryTick = 0;
+            retryDelay = 1;
+        }
+        lastTick = sim.getTicks();
+        lastAppleCount = sim.getAppleCount();
+        int open = cols * rows - sim.getObstacles().getCount() - static_cast<int>(length);
+        unsigned freeCells = static_cast<unsigned>(std::max(open, 0));
+        bool stalled = sim.getTicks() - lastMealTick > length + 2ULL * freeCells;
+
+        int planned = plannedMove(sim, headIndex);
+        if (planned >= 0) {
+            ++planNext;
+            ++planTick;
+            planHead = plan[planNext - 1];
+            return actions[planned];
+        }
+        plan.clear();
+        snapshotBody(sim);
+
+        Position tailCell = snake.getBody().back();
+        int tailIndex = indexOf(tailCell.x, tailCell.y);
+        int excluded = snake.getBody().size() > 1 ? reverseOf(snake.getDirection()) : -1;
+        auto isTail = [tailIndex](int index) { return index == tailIndex; };
+
+        int appleIndex = indexOf(sim.getApple().x, sim.getApple().y);
+        int blueIndex = sim.isBlueAppleVisible() ? indexOf(sim.getBlueApple().x, sim.getBlueApple().y) : -1;
+        // A blue apple only counts if the head gets there before it goes
+        unsigned blueMovesLeft = sim.getBlueAppleMovesLeft();
+        auto isFood = [this, appleIndex, blueIndex, blueMovesLeft](int index) {
+            return index == appleIndex || (index == blueIndex && distance[index] <= blueMovesLeft);
+        };
+        // Eating on the first step keeps the tail in place one tick longer,
+        // which is the same as searching from one tick earlier
+        auto tailSearchFrom = [&](const Position& next) {
+            int index = indexOf(next.x, next.y);
+            if (index == tailIndex) {
+                SearchResult onTail = { 0, index, 0, 1 };
+                return onTail;
+            }
+            bool eats = index == appleIndex || (index == blueIndex && blueMovesLeft >= 1);
+            return search(next, eats ? 0 : 1, -1, isTail);
+        };
+
+        SearchResult food = { -1, -1, 0, 0 };
+        if (stalled || sim.getTicks() >= retryTick) food = search(head, 0, excluded, isFood);
+        if (food.move >= 0) {
+            // Traced before the safety search overwrites parent[]
+            tracePlan(food.target, headIndex);
+            if (stalled || safeAfterEating(sim, food.target, headIndex)) {
+                keepPlan(sim);
+                return actions[food.move];
+            }
+            plan.clear();
+            snapshotBody(sim);
+        }
+        if (sim.getTicks() >= retryTick) {
+            retryTick = sim.getTicks() + retryDelay;
+            retryDelay = std::min(retryDelay * 2, static_cast<unsigned>(maxRetryDelay));
+        }
+
+        // No safe way to food: keep the tail in reach, along the longest way
+        // there. Only when no move reaches the tail is the room counted, and
+        // then no further than the body is long, since more room than that
+        // is as good as any.
+        int bestMove = -1;
+        unsigned bestLength = 0;
+        for (int move = 0; move < 4; ++move) {
+            if (move == excluded) continue;
+            Position next{ head.x + moveX(move), head.y + moveY(move) };
+            if (!passable(next.x, next.y, 1)) continue;
+            SearchResult toTail = tailSearchFrom(next);
+            if (toTail.move >= 0 && (bestMove < 0 || toTail.length > bestLength)) {
+                bestMove = move;
+                bestLength = toTail.length;
+            }
+        }
+        if (bestMove >= 0) return actions[bestMove];
+
+        unsigned bestRoom = 0;
+        for (int move = 0; move < 4; ++move) {
+            if (move == excluded) continue;
+            Position next{ head.x + moveX(move), head.y + moveY(move) };
+            if (!passable(next.x, next.y, 1)) continue;
+            unsigned room = search(next, 1, -1, [](int) { return false; }, length + 1).reached;
+            if (bestMove < 0 || room > bestRoom) {
+                bestMove = move;
+                bestRoom = room;
+            }
+        }
+        return bestMove >= 0 ? actions[bestMove] : GameSimulation::Action::None;
+    }
+};
+
+#endif // AUTOPILOT_H
\ No newline at end of file
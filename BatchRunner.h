@@ -0,0 +1,260 @@
+#ifndef BATCHRUNNER_H
+#define BATCHRUNNER_H
+
+#include "GameSimulation.h"
+#include "GameRandom.h"
+#include "BotPolicy.h"
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <memory>
+#include <string>
+#include <cstdio>
+#include <cstdint>
+#include <algorithm>
+
+// Counts values into fixed-width buckets; the last bucket collects
+// everything past the end. Exact count, sum, min and max are kept alongside
+// so the mean does not suffer from the bucketing.
+class Histogram {
+private:
+    std::vector<unsigned long long> buckets;
+    unsigned bucketWidth;
+    unsigned long long count;
+    unsigned long long sum;
+    unsigned long long minimum;
+    unsigned long long maximum;
+
+public:
+    Histogram(unsigned bucketWidth, size_t bucketCount)
+        : buckets(bucketCount, 0), bucketWidth(bucketWidth), count(0), sum(0), minimum(0), maximum(0) {}
+
+    void add(unsigned long long value) {
+        size_t index = std::min(static_cast<size_t>(value / bucketWidth), buckets.size() - 1);
+        ++buckets[index];
+        if (count == 0 || value < minimum) minimum = value;
+        if (count == 0 || value > maximum) maximum = value;
+        ++count;
+        sum += value;
+    }
+
+    void merge(const Histogram& other) {
+        for (size_t i = 0; i < buckets.size(); ++i) buckets[i] += other.buckets[i];
+        if (other.count > 0) {
+            if (count == 0 || other.minimum < minimum) minimum = other.minimum;
+            if (count == 0 || other.maximum > maximum) maximum = other.maximum;
+        }
+        count += other.count;
+        sum += other.sum;
+    }
+
+    // Upper edge of the bucket holding the given fraction of values
+    unsigned long long percentile(double fraction) const {
+        unsigned long long rank = static_cast<unsigned long long>(fraction * count);
+        unsigned long long seen = 0;
+        for (size_t i = 0; i < buckets.size(); ++i) {
+            seen += buckets[i];
+            if (seen > rank) return std::min<unsigned long long>((i + 1) * bucketWidth - 1, maximum);
+        }
+        return maximum;
+    }
+
+    void print(std::FILE* out, const char* label) const {
+        std::fprintf(out, "%s: mean %.2f, min %llu, p50 %llu, p90 %llu, p99 %llu, max %llu\n", label,
+            count > 0 ? static_cast<double>(sum) / count : 0.0, minimum,
+            percentile(0.5), percentile(0.9), percentile(0.99), maximum);
+        unsigned long long peak = *std::max_element(buckets.begin(), buckets.end());
+        for (size_t i = 0; i < buckets.size(); ++i) {
+            if (buckets[i] == 0) continue;
+            int bar = peak > 0 ? static_cast<int>(40 * buckets[i] / peak) : 0;
+            if (i + 1 < buckets.size()) {
+                std::fprintf(out, "  %6llu-%-6llu %10llu ", static_cast<unsigned long long>(i * bucketWidth),
+                    static_cast<unsigned long long>((i + 1) * bucketWidth - 1), buckets[i]);
+            }
+            else {
+                std::fprintf(out, "  %6llu+       %10llu ", static_cast<unsigned long long>(i * bucketWidth), buckets[i]);
+            }
+            for (int k = 0; k < bar; ++k) std::fputc('#', out);
+            std::fputc('\n', out);
+        }
+    }
+};
+
+// Aggregates of a batch. Every worker fills its own copy and they are merged
+// once at the end, so recording a game never touches shared memory.
+struct BatchStats {
+    static const int outcomeCount = 5;
+
+    unsigned long long games;
+    unsigned long long ticks;
+    unsigned long long timeouts; // Games cut off by the per-game tick cap
+    unsigned long long outcomes[outcomeCount];
+    Histogram score;
+    Histogram length;
+    Histogram survivalSeconds;
+
+    BatchStats() : games(0), ticks(0), timeouts(0), score(10, 100), length(10, 60), survivalSeconds(10, 60) {
+        std::fill(outcomes, outcomes + outcomeCount, 0ULL);
+    }
+
+    void record(const GameSimulation& sim) {
+        ++games;
+        ticks += sim.getTicks();
+        if (sim.isOver()) ++outcomes[static_cast<int>(sim.getOutcome())];
+        else ++timeouts;
+        score.add(static_cast<unsigned long long>(std::max(sim.getScore(), 0)));
+        length.add(sim.getSnake().getBody().size());
+        survivalSeconds.add(static_cast<unsigned long long>(sim.getTicks() * sim.getMoveInterval()));
+    }
+
+    void merge(const BatchStats& other) {
+        games += other.games;
+        ticks += other.ticks;
+        timeouts += other.timeouts;
+        for (int i = 0; i < outcomeCount; ++i) outcomes[i] += other.outcomes[i];
+        score.merge(other.score);
+        length.merge(other.length);
+        survivalSeconds.merge(other.survivalSeconds);
+    }
+
+    void print(std::FILE* out) const {
+        static const char* outcomeNames[outcomeCount] = { "running", "hit wall", "hit self", "hit bomb", "board full" };
+        std::fprintf(out, "Death causes:\n");
+        for (int i = 1; i < outcomeCount; ++i) {
+            std::fprintf(out, "  %-12s %10llu (%.2f%%)\n", outcomeNames[i], outcomes[i],
+                games > 0 ? 100.0 * outcomes[i] / games : 0.0);
+        }
+        std::fprintf(out, "  %-12s %10llu (%.2f%%)\n", "tick cap", timeouts, games > 0 ? 100.0 * timeouts / games : 0.0);
+        score.print(out, "Score");
+        length.print(out, "Length");
+        survivalSeconds.print(out, "Survival (s)");
+    }
+};
+
+// Plays games [0, gameCount) on a pool of threads. Game i always uses seed
+// firstSeed + i for both the simulation and the bot, so the aggregates do
+// not depend on the thread count or on which thread ran which game.
+//
+// Work is split into one contiguous range per worker. A worker takes small
+// chunks off the front of its own range; when that runs dry it steals the
+// back half of the next range that still has work. Ranges are guarded by their
+// own mutex, touched once per chunk, so the locks are all but uncontended
+// and fast and slow games balance out across cores.
+class BatchRunner {
+private:
+    struct WorkRange {
+        std::mutex lock;
+        unsigned long long next;
+        unsigned long long end;
+    };
+
+    static const unsigned long long chunkSize = 32;
+
+    GameSimulation::Level level;
+    const LevelDefinition* loadedLevel; // Played instead of level when set
+    int boardCols;
+    int boardRows;
+    std::uint64_t firstSeed;
+    unsigned long long maxTicksPerGame;
+    std::string policyName;
+    unsigned threadCount;
+    std::unique_ptr<WorkRange[]> ranges;
+
+    bool takeChunk(unsigned worker, unsigned long long& first, unsigned long long& last) {
+        {
+            WorkRange& own = ranges[worker];
+            std::lock_guard<std::mutex> guard(own.lock);
+            if (own.next < own.end) {
+                first = own.next;
+                last = std::min(own.end, own.next + chunkSize);
+                own.next = last;
+                return true;
+            }
+        }
+        for (unsigned offset = 1; offset < threadCount; ++offset) {
+            WorkRange& victim = ranges[(worker + offset) % threadCount];
+            {
+                std::lock_guard<std::mutex> guard(victim.lock);
+                unsigned long long remaining = victim.end - victim.next;
+                if (remaining == 0) continue;
+                first = victim.next + remaining / 2;
+                last = victim.end;
+                victim.end = first;
+            }
+            // Keep one chunk and park the rest of the stolen half in our own
+            // range. Only one lock is ever held at a time, so two workers
+            // stealing from each other cannot deadlock.
+            if (last - first > chunkSize) {
+                WorkRange& own = ranges[worker];
+                std::lock_guard<std::mutex> guard(own.lock);
+                own.next = first + chunkSize;
+                own.end = last;
+                last = own.next;
+            }
+            return true;
+        }
+        return false;
+    }
+
+    void work(unsigned worker, BatchStats& stats) {
+        std::unique_ptr<BotPolicy> policy = createPolicy(policyName);
+        GameSimulation sim;
+        sim.setBoardSize(boardCols, boardRows);
+        GameRandom rng;
+        unsigned long long first, last;
+        while (takeChunk(worker, first, last)) {
+            for (unsigned long long game = first; game < last; ++game) {
+                if (loadedLevel) sim.reset(*loadedLevel, firstSeed + game);
+                else sim.reset(level, firstSeed + game);
+                rng.seed(firstSeed + game, 0);
+                policy->begin(sim);
+                while (!sim.isOver() && sim.getTicks() < maxTicksPerGame) {
+                    sim.step(policy->choose(sim, rng));
+                }
+                stats.record(sim);
+            }
+        }
+    }
+
+public:
+    BatchRunner(GameSimulation::Level level, std::uint64_t firstSeed, unsigned long long maxTicksPerGame,
+        const std::string& policyName, unsigned threadCount)
+        : level(level), loadedLevel(nullptr), boardCols(GameSimulation::startCols), boardRows(GameSimulation::startRows), firstSeed(firstSeed), maxTicksPerGame(maxTicksPerGame), policyName(policyName),
+          threadCount(std::max(threadCount, 1u)) {}
+
+    void setBoardSize(int cols, int rows) {
+        boardCols = cols;
+        boardRows = rows;
+    }
+
+    // Plays a level loaded from a file instead, on its own board size. The
+    // definition is shared by the workers and must outlive run().
+    void setLoadedLevel(const LevelDefinition* definition) {
+        loadedLevel = definition;
+    }
+
+    BatchStats run(unsigned long long gameCount) {
+        ranges.reset(new WorkRange[threadCount]);
+        for (unsigned i = 0; i < threadCount; ++i) {
+            ranges[i].next = gameCount * i / threadCount;
+            ranges[i].end = gameCount * (i + 1) / threadCount;
+        }
+
+        std::vector<BatchStats> results(threadCount);
+        std::vector<std::thread> workers;
+        workers.reserve(threadCount);
+        for (unsigned i = 1; i < threadCount; ++i) {
+            workers.push_back(std::thread(&BatchRunner::work, this, i, std::ref(results[i])));
+        }
+        work(0, results[0]);
+        for (size_t i = 0; i < workers.size(); ++i) workers[i].join();
+
+        BatchStats total;
+        for (unsigned i = 0; i < threadCount; ++i) total.merge(results[i]);
+        return total;
+    }
+
+    unsigned getThreadCount() const { return threadCount; }
+};
+
+#endif // BATCHRUNNER_H
\ No newline at end of file
@@ -0,0 +1,372 @@
+#include "GameSimulation.h"
+#include "Snake.h"
+#include "Apple.h"
+#include "OccupancyGrid.h"
+#include "GameRandom.h"
+#include "SnakeArena.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// Microbenchmarks for the game core, printed as JSON so runs can be saved
+// and compared:
+//
+//   snake_bench [--filter TEXT] [--max-side N] [--min-time SECONDS]
+//
+// Each benchmark repeats one operation until it has run for --min-time,
+// timing only the operation itself (setup between batches is excluded), and
+// reports nanoseconds and heap allocations per operation. The boards go from
+// the classic 23x18 up to 1000x1000, and the arena's up to 2000x2000;
+// --max-side skips the bigger ones.
+
+namespace {
+    // Every operator new in the process goes through here
+    unsigned long long allocationCount = 0;
+}
+
+void* operator new(std::size_t size) {
+    ++allocationCount;
+    if (void* memory = std::malloc(size ? size : 1)) return memory;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    ++allocationCount;
+    if (void* memory = std::malloc(size ? size : 1)) return memory;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { std::free(memory); }
+
+namespace {
+    // Keeps the optimiser from deleting or hoisting work whose result is
+    // never used: the value is written somewhere it cannot see through, and
+    // clobber() makes it assume any memory may have changed.
+    volatile long long sink;
+
+    template <typename T>
+    void keep(const T& value) {
+        sink = static_cast<long long>(value);
+    }
+
+    void clobber() {
+#ifdef _MSC_VER
+        _ReadWriteBarrier();
+#else
+        asm volatile("" : : : "memory");
+#endif
+    }
+
+    // Times only the stretches between start() and stop(), and counts the
+    // allocations made in them
+    class Stopwatch {
+    private:
+        typedef std::chrono::steady_clock Clock;
+        Clock::time_point started;
+        unsigned long long allocationsAtStart;
+        double nanoseconds;
+        unsigned long long allocations;
+
+    public:
+        Stopwatch() : allocationsAtStart(0), nanoseconds(0), allocations(0) {}
+
+        void start() {
+            allocationsAtStart = allocationCount;
+            started = Clock::now();
+        }
+
+        void stop() {
+            Clock::time_point now = Clock::now();
+            nanoseconds += std::chrono::duration<double, std::nano>(now - started).count();
+            allocations += allocationCount - allocationsAtStart;
+        }
+
+        double getNanoseconds() const { return nanoseconds; }
+        unsigned long long getAllocations() const { return allocations; }
+    };
+
+    struct Board {
+        int cols;
+        int rows;
+    };
+
+    struct Result {
+        std::string name;
+        Board board;
+        double fill; // Share of the board covered, or -1 where it does not apply
+        unsigned long long ops;
+        double nsPerOp;
+        double allocsPerOp;
+    };
+
+    struct Options {
+        std::string filter;
+        int maxSide;
+        double minTime;
+    };
+
+    // One lap of a Hamiltonian cycle that the starting snake (3..5, 9),
+    // heading right, already lies on: column 0 runs down, odd rows run right
+    // from column 1, even rows run left back to column 1, and the row above
+    // is entered from the row's end. Needs an even row count. A snake that
+    // keeps to it never hits a wall or itself, however long it is.
+    GameSimulation::Action cycleMove(const Position& head, int cols, int rows) {
+        typedef GameSimulation::Action Action;
+        if (head.x == 0) return head.y < rows - 1 ? Action::Down : Action::Right;
+        if (head.y % 2 == 1) return head.x < cols - 1 ? Action::Right : Action::Up;
+        if (head.x > 1) return Action::Left;
+        return head.y == 0 ? Action::Left : Action::Up;
+    }
+
+    void steer(Snake& snake, GameSimulation::Action action) {
+        switch (action) {
+        case GameSimulation::Action::Up: snake.setDirection(0, -1); break;
+        case GameSimulation::Action::Down: snake.setDirection(0, 1); break;
+        case GameSimulation::Action::Left: snake.setDirection(-1, 0); break;
+        case GameSimulation::Action::Right: snake.setDirection(1, 0); break;
+        default: break;
+        }
+    }
+
+    // A snake covering fill of the board, laid along the cycle
+    Snake makeSnake(const Board& board, double fill) {
+        Snake snake(board.cols, board.rows);
+        size_t length = std::max<size_t>(3, static_cast<size_t>(fill * board.cols * board.rows));
+        while (snake.getBody().size() < length) {
+            steer(snake, cycleMove(snake.getHead(), board.cols, board.rows));
+            snake.grow();
+            snake.update();
+        }
+        return snake;
+    }
+
+    // A grid with fill of its cells taken, chosen at random
+    OccupancyGrid makeGrid(const Board& board, double fill) {
+        OccupancyGrid grid(board.cols, board.rows);
+        std::vector<Position> cells;
+        cells.reserve(static_cast<size_t>(board.cols) * board.rows);
+        for (int y = 0; y < board.rows; ++y) {
+            for (int x = 0; x < board.cols; ++x) cells.push_back({ x, y });
+        }
+        GameRandom rng(7, 0);
+        size_t taken = static_cast<size_t>(fill * cells.size());
+        for (size_t i = 0; i < taken; ++i) {
+            size_t pick = i + rng.nextBelow(static_cast<std::uint32_t>(cells.size() - i));
+            std::swap(cells[i], cells[pick]);
+            grid.add(cells[i]);
+        }
+        return grid;
+    }
+
+    class Suite {
+    private:
+        Options options;
+        std::vector<Result> results;
+
+        bool wanted(const std::string& name, const Board& board) const {
+            return name.find(options.filter) != std::string::npos &&
+                board.cols <= options.maxSide && board.rows <= options.maxSide;
+        }
+
+    public:
+        explicit Suite(const Options& options) : options(options) {}
+
+        // run(ops, stopwatch) performs ops operations, timing them with the
+        // stopwatch. The count grows until a run lasts minTime.
+        template <typename Run>
+        void measure(const std::string& name, const Board& board, double fill, Run run,
+            unsigned long long maxOps = 1ULL << 32) {
+            if (!wanted(name, board)) return;
+            unsigned long long ops = 1;
+            Stopwatch stopwatch;
+            while (true) {
+                stopwatch = Stopwatch();
+                run(ops, stopwatch);
+                double seconds = stopwatch.getNanoseconds() * 1e-9;
+                if (seconds >= options.minTime || ops >= maxOps) break;
+                double scale = seconds > 0 ? 1.2 * options.minTime / seconds : 100.0;
+                ops = std::min(maxOps, static_cast<unsigned long long>(ops * std::min(100.0, std::max(2.0, scale))));
+            }
+            Result result;
+            result.name = name;
+            result.board = board;
+            result.fill = fill;
+            result.ops = ops;
+            result.nsPerOp = stopwatch.getNanoseconds() / ops;
+            result.allocsPerOp = static_cast<double>(stopwatch.getAllocations()) / ops;
+            results.push_back(result);
+            std::fprintf(stderr, "%-16s %5dx%-5d fill %5.2f  %12.1f ns/op  %8.3f allocs/op\n", name.c_str(),
+                board.cols, board.rows, fill < 0 ? 0.0 : fill, result.nsPerOp, result.allocsPerOp);
+        }
+
+        void print(FILE* out) const {
+            std::fprintf(out, "{\n  \"benchmarks\": [\n");
+            for (size_t i = 0; i < results.size(); ++i) {
+                const Result& result = results[i];
+                std::fprintf(out, "    {\"name\": \"%s\", \"cols\": %d, \"rows\": %d, ", result.name.c_str(),
+                    result.board.cols, result.board.rows);
+                if (result.fill >= 0) std::fprintf(out, "\"fill\": %.2f, ", result.fill);
+                std::fprintf(out, "\"ops\": %llu, \"ns_per_op\": %.3f, \"allocs_per_op\": %.4f}%s\n",
+                    result.ops, result.nsPerOp, result.allocsPerOp, i + 1 < results.size() ? "," : "");
+            }
+            std::fprintf(out, "  ]\n}\n");
+        }
+    };
+
+    void benchSnake(Suite& suite, const Board& board, double fill) {
+        // Steering is part of each op, as it is in a game tick
+        suite.measure("snake_update", board, fill, [&](unsigned long long ops, Stopwatch& stopwatch) {
+            Snake snake = makeSnake(board, fill);
+            stopwatch.start();
+            for (unsigned long long i = 0; i < ops; ++i) {
+                steer(snake, cycleMove(snake.getHead(), board.cols, board.rows));
+                snake.update();
+            }
+            stopwatch.stop();
+            keep(snake.getHead().x);
+        });
+
+        suite.measure("self_collision", board, fill, [&](unsigned long long ops, Stopwatch& stopwatch) {
+            Snake snake = makeSnake(board, fill);
+            long long hits = 0;
+            stopwatch.start();
+            for (unsigned long long i = 0; i < ops; ++i) {
+                hits += snake.checkSelfCollision();
+                clobber();
+            }
+            stopwatch.stop();
+            keep(hits);
+        });
+    }
+
+    void benchRespawn(Suite& suite, const Board& board, double fill) {
+        suite.measure("apple_respawn", board, fill, [&](unsigned long long ops, Stopwatch& stopwatch) {
+            OccupancyGrid grid = makeGrid(board, fill);
+            Apple apple;
+            apple.seed(1, 1);
+            long long sum = 0;
+            stopwatch.start();
+            for (unsigned long long i = 0; i < ops; ++i) {
+                apple.respawn(grid);
+                sum += apple.getPosition().x;
+            }
+            stopwatch.stop();
+            keep(sum);
+        });
+    }
+
+    // One Level 3 shrink of a half-full board: clamping the body inside the
+    // smaller bounds and rebuilding the occupancy grid. Each op shrinks a
+    // fresh copy, made outside the timing. The copy is assigned into a snake
+    // built for the board, so its buffers keep the capacity a game's have.
+    void benchShrink(Suite& suite, const Board& board) {
+        const double fill = 0.5;
+        suite.measure("level3_shrink", board, fill, [&](unsigned long long ops, Stopwatch& stopwatch) {
+            Snake original = makeSnake(board, fill);
+            Snake snake(board.cols, board.rows);
+            for (unsigned long long i = 0; i < ops; ++i) {
+                snake = original;
+                stopwatch.start();
+                snake.clampTo(board.cols - 1, board.rows - 1);
+                stopwatch.stop();
+                keep(snake.getOccupancy().getFreeCount());
+            }
+        }, 4096);
+    }
+
+    // GameSimulation::step on the given level, steered along the cycle so
+    // the snake eats and grows. A game that ends is reset outside the timing.
+    void benchTick(Suite& suite, const Board& board, GameSimulation::Level level, const char* name) {
+        suite.measure(name, board, -1, [&](unsigned long long ops, Stopwatch& stopwatch) {
+            GameSimulation sim;
+            sim.setBoardSize(board.cols, board.rows);
+            std::uint64_t seed = 1;
+            sim.reset(level, seed);
+            unsigned long long done = 0;
+            while (done < ops) {
+                stopwatch.start();
+                while (done < ops && !sim.isOver()) {
+                    sim.step(cycleMove(sim.getSnake().getHead(), sim.getCols(), sim.getRows()));
+                    ++done;
+                }
+                stopwatch.stop();
+                if (sim.isOver()) sim.reset(level, ++seed);
+            }
+            keep(sim.getScore());
+        });
+    }
+
+    // One SnakeArena::step with every snake a bot and one apple per snake,
+    // after a second of play so the bots are spread out and growing. Each
+    // board has its own population, one snake per 400 cells.
+    void benchArena(Suite& suite, const Board& board, int snakes) {
+        suite.measure("arena_tick", board, -1, [&](unsigned long long ops, Stopwatch& stopwatch) {
+            ArenaSettings settings;
+            settings.cols = board.cols;
+            settings.rows = board.rows;
+            settings.snakes = snakes;
+            settings.players = 0;
+            settings.apples = snakes;
+            SnakeArena arena;
+            arena.reset(settings, 1);
+            for (int i = 0; i < 60; ++i) arena.step();
+            stopwatch.start();
+            for (unsigned long long i = 0; i < ops; ++i) arena.step();
+            stopwatch.stop();
+            keep(arena.getAliveCount());
+        }, 2048);
+    }
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    options.maxSide = SnakeArena::maxBoardSide;
+    options.minTime = 0.2;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            options.filter = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--max-side") == 0 && i + 1 < argc) {
+            options.maxSide = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--min-time") == 0 && i + 1 < argc) {
+            options.minTime = std::atof(argv[++i]);
+        }
+        else {
+            std::printf("Usage: %s [--filter TEXT] [--max-side N] [--min-time SECONDS]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    // Every size has an even row count, which the cycle needs
+    const Board boards[] = { { 23, 18 }, { 100, 100 }, { 400, 300 }, { 1000, 1000 } };
+    const double snakeFills[] = { 0.1, 0.5, 0.99 };
+    const double respawnFills[] = { 0.1, 0.25, 0.5, 0.75, 0.9, 0.99 };
+
+    Suite suite(options);
+    for (const Board& board : boards) {
+        for (double fill : snakeFills) benchSnake(suite, board, fill);
+        for (double fill : respawnFills) benchRespawn(suite, board, fill);
+        benchShrink(suite, board);
+        benchTick(suite, board, GameSimulation::Level::Level1, "tick_level1");
+        benchTick(suite, board, GameSimulation::Level::Level3, "tick_level3");
+    }
+    // The arena's target: 10,000 bots on 2000x2000 within a 60 ticks/s frame
+    benchArena(suite, Board{ 400, 300 }, 300);
+    benchArena(suite, Board{ 1000, 1000 }, 2500);
+    benchArena(suite, Board{ 2000, 2000 }, 10000);
+    suite.print(stdout);
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,67 @@
+#ifndef BOARDCAMERA_H
+#define BOARDCAMERA_H
+
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cmath>
+
+// sf::View over the play area for boards too big to show whole. The board
+// lives in world space with cell (x, y) at (x * cellSize, y * cellSize); the
+// view keeps the head centred, stops at the board edges, and zooms between
+// close-up and a fixed widest view so the number of visible cells, and with
+// it the vertex count, has a hard ceiling whatever the board size.
+class BoardCamera {
+private:
+    sf::View view;
+    sf::Vector2f screenSize; // Play area in window pixels
+    float cellSize;
+    float zoom; // World units per screen pixel
+
+    static constexpr float minZoom = 0.5f;
+    static constexpr float maxZoom = 8.0f;
+
+public:
+    // area is the play area in window pixels, windowSize the whole window
+    BoardCamera(float cellSize, const sf::FloatRect& area, const sf::Vector2f& windowSize)
+        : screenSize(area.width, area.height), cellSize(cellSize), zoom(1.0f) {
+        view.setViewport(sf::FloatRect(area.left / windowSize.x, area.top / windowSize.y,
+            area.width / windowSize.x, area.height / windowSize.y));
+        view.setSize(screenSize * zoom);
+    }
+
+    // factor > 1 zooms out
+    void zoomBy(float factor) {
+        // Copies, since std::min/max take references and would odr-use the constants
+        float lowest = minZoom;
+        float highest = maxZoom;
+        zoom = std::min(std::max(zoom * factor, lowest), highest);
+        view.setSize(screenSize * zoom);
+    }
+
+    // Centres on a (possibly fractional) cell, clamped so the view never
+    // leaves the board; a board smaller than the view sits in the middle
+    void follow(const sf::Vector2f& cell, int cols, int rows) {
+        sf::Vector2f size = view.getSize();
+        sf::Vector2f board(cols * cellSize, rows * cellSize);
+        sf::Vector2f center((cell.x + 0.5f) * cellSize, (cell.y + 0.5f) * cellSize);
+        center.x = board.x <= size.x ? board.x / 2 : std::min(std::max(center.x, size.x / 2), board.x - size.x / 2);
+        center.y = board.y <= size.y ? board.y / 2 : std::min(std::max(center.y, size.y / 2), board.y - size.y / 2);
+        view.setCenter(center);
+    }
+
+    // Cells at least partly on screen, clipped to the board
+    sf::IntRect getVisibleCells(int cols, int rows) const {
+        sf::Vector2f center = view.getCenter();
+        sf::Vector2f half = view.getSize() / 2.0f;
+        int left = std::max(0, static_cast<int>(std::floor((center.x - half.x) / cellSize)));
+        int top = std::max(0, static_cast<int>(std::floor((center.y - half.y) / cellSize)));
+        int right = std::min(cols, static_cast<int>(std::ceil((center.x + half.x) / cellSize)));
+        int bottom = std::min(rows, static_cast<int>(std::ceil((center.y + half.y) / cellSize)));
+        return sf::IntRect(left, top, std::max(0, right - left), std::max(0, bottom - top));
+    }
+
+    const sf::View& getView() const { return view; }
+    float getCellSize() const { return cellSize; }
+};
+
+#endif // BOARDCAMERA_H
\ No newline at end of file
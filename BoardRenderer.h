@@ -0,0 +1,66 @@
+#ifndef BOARDRENDERER_H
+#define BOARDRENDERER_H
+
+#include <SFML/Graphics.hpp>
+#include "ObstacleMap.h"
+
+// Checkerboard background baked into one vertex array. The quads are only
+// rebuilt when the board size, the level colours or the game change (level
+// start and Level 3's wall shrink), and the whole board goes out in a single
+// draw call. A loaded level's walls are cells of their own colour.
+class BoardRenderer {
+private:
+    sf::VertexArray cells;
+    int builtCols;
+    int builtRows;
+    sf::Color builtColor1;
+    sf::Color builtColor2;
+    sf::Color builtObstacleColor;
+    unsigned builtRevision;
+    float cellSize;
+    sf::Vector2f origin;
+
+    void rebuild(int cols, int rows, const sf::Color& color1, const sf::Color& color2,
+        const ObstacleMap& obstacles, const sf::Color& obstacleColor) {
+        cells.resize(static_cast<size_t>(cols) * rows * 4);
+        bool walls = !obstacles.empty();
+        size_t v = 0;
+        for (int i = 0; i < cols; ++i) {
+            for (int j = 0; j < rows; ++j) {
+                float left = origin.x + i * cellSize;
+                float top = origin.y + j * cellSize;
+                const sf::Color& color = walls && obstacles.test(Position{ i, j }) ? obstacleColor :
+                    (i + j) % 2 == 0 ? color1 : color2;
+                cells[v + 0] = sf::Vertex(sf::Vector2f(left, top), color);
+                cells[v + 1] = sf::Vertex(sf::Vector2f(left + cellSize, top), color);
+                cells[v + 2] = sf::Vertex(sf::Vector2f(left + cellSize, top + cellSize), color);
+                cells[v + 3] = sf::Vertex(sf::Vector2f(left, top + cellSize), color);
+                v += 4;
+            }
+        }
+        builtCols = cols;
+        builtRows = rows;
+        builtColor1 = color1;
+        builtColor2 = color2;
+        builtObstacleColor = obstacleColor;
+    }
+
+public:
+    BoardRenderer(float cellSize, const sf::Vector2f& origin)
+        : cells(sf::Quads), builtCols(0), builtRows(0), builtRevision(0), cellSize(cellSize), origin(origin) {}
+
+    // Cheap to call every frame: only does work when something changed.
+    // revision is GameSimulation::getBoardRevision.
+    void update(int cols, int rows, const sf::Color& color1, const sf::Color& color2,
+        const ObstacleMap& obstacles, const sf::Color& obstacleColor, unsigned revision) {
+        if (cols != builtCols || rows != builtRows || color1 != builtColor1 || color2 != builtColor2 ||
+            obstacleColor != builtObstacleColor || revision != builtRevision) {
+            rebuild(cols, rows, color1, color2, obstacles, obstacleColor);
+            builtRevision = revision;
+        }
+    }
+
+    const sf::VertexArray& getVertices() const { return cells; }
+};
+
+#endif // BOARDRENDERER_H
@@ -0,0 +1,30 @@
+#ifndef BOMB_H
+#define BOMB_H
+
+#include "Position.h"
+#include "OccupancyGrid.h"
+#include "GameRandom.h"
+#include <cstdint>
+
+class Bomb {
+private:
+    Position position;
+    GameRandom rng;
+
+public:
+    Bomb() : position{ 0, 0 } {}
+
+    void seed(std::uint64_t gameSeed, std::uint64_t stream) {
+        rng.seed(gameSeed, stream);
+    }
+
+    // Draws from the grid's free-cell list, so this takes the same time on an
+    // empty board as on a nearly full one. Returns false when no cell is free.
+    bool respawn(const OccupancyGrid& occupied) {
+        return occupied.pickFreeCell(rng, position);
+    }
+
+    Position getPosition() const { return position; }
+};
+
+#endif // BOMB_H
@@ -0,0 +1,155 @@
+#ifndef BOTPOLICY_H
+#define BOTPOLICY_H
+
+#include "GameSimulation.h"
+#include "GameRandom.h"
+#include "Autopilot.h"
+#include "HamiltonianSolver.h"
+#include <memory>
+#include <string>
+#include <cstdlib>
+
+// A bot that plays GameSimulation headlessly. Each worker thread owns its own
+// policy object, so a policy may keep scratch state between calls without
+// locking; all randomness must come from the GameRandom it is handed so a
+// game plays the same no matter which thread runs it.
+class BotPolicy {
+public:
+    virtual ~BotPolicy() {}
+    virtual const char* getName() const = 0;
+    // Called once before each game
+    virtual void begin(const GameSimulation&) {}
+    virtual GameSimulation::Action choose(const GameSimulation& sim, GameRandom& rng) = 0;
+};
+
+namespace BotMoves {
+    static const GameSimulation::Action actions[] = {
+        GameSimulation::Action::Up, GameSimulation::Action::Down,
+        GameSimulation::Action::Left, GameSimulation::Action::Right
+    };
+    static const int dx[] = { 0, 0, -1, 1 };
+    static const int dy[] = { -1, 1, 0, 0 };
+
+    // Fills safe[] with the moves that do not end the game next tick and
+    // returns how many there are; straight is the one keeping direction, or -1
+    inline int findSafe(const GameSimulation& sim, int safe[4], int& straight) {
+        Position head = sim.getSnake().getHead();
+        Position direction = sim.getSnake().getDirection();
+        int safeCount = 0;
+        straight = -1;
+        for (int i = 0; i < 4; ++i) {
+            if (dx[i] == -direction.x && dy[i] == -direction.y) continue;
+            Position next{ head.x + dx[i], head.y + dy[i] };
+            if (sim.isBlocked(next)) continue;
+            if (dx[i] == direction.x && dy[i] == direction.y) straight = i;
+            safe[safeCount++] = i;
+        }
+        return safeCount;
+    }
+}
+
+// Picks a random move that does not end the game on the next tick, mostly
+// keeping straight so games run long enough to exercise every system.
+class RandomPolicy : public BotPolicy {
+public:
+    const char* getName() const override { return "random"; }
+
+    GameSimulation::Action choose(const GameSimulation& sim, GameRandom& rng) override {
+        int safe[4];
+        int straight;
+        int safeCount = BotMoves::findSafe(sim, safe, straight);
+        if (safeCount == 0) return GameSimulation::Action::None;
+        if (straight >= 0 && rng.nextBelow(4) != 0) return BotMoves::actions[straight];
+        return BotMoves::actions[safe[rng.nextBelow(safeCount)]];
+    }
+};
+
+// Heads for the nearest apple by Manhattan distance among the safe moves,
+// with ties broken at random. Plays like a hungry beginner: scores quickly,
+// then boxes itself in.
+class GreedyPolicy : public BotPolicy {
+public:
+    const char* getName() const override { return "greedy"; }
+
+    GameSimulation::Action choose(const GameSimulation& sim, GameRandom& rng) override {
+        int safe[4];
+        int straight;
+        int safeCount = BotMoves::findSafe(sim, safe, straight);
+        if (safeCount == 0) return GameSimulation::Action::None;
+
+        Position head = sim.getSnake().getHead();
+        Position target = sim.getApple();
+        if (sim.isBlueAppleVisible()) {
+            Position blue = sim.getBlueApple();
+            if (std::abs(blue.x - head.x) + std::abs(blue.y - head.y) <
+                std::abs(target.x - head.x) + std::abs(target.y - head.y)) {
+                target = blue;
+            }
+        }
+
+        int best[4];
+        int bestCount = 0;
+        int bestDistance = 0;
+        for (int i = 0; i < safeCount; ++i) {
+            int move = safe[i];
+            int distance = std::abs(head.x + BotMoves::dx[move] - target.x) +
+                std::abs(head.y + BotMoves::dy[move] - target.y);
+            if (bestCount == 0 || distance < bestDistance) {
+                bestDistance = distance;
+                bestCount = 0;
+            }
+            if (distance == bestDistance) best[bestCount++] = move;
+        }
+        return BotMoves::actions[best[bestCount == 1 ? 0 : rng.nextBelow(bestCount)]];
+    }
+};
+
+// Plays with the search-based Autopilot, which needs no randomness
+class AutopilotPolicy : public BotPolicy {
+private:
+    Autopilot autopilot;
+
+public:
+    const char* getName() const override { return "autopilot"; }
+
+    void begin(const GameSimulation& sim) override {
+        autopilot.prepare(sim.getCols(), sim.getRows());
+    }
+
+    GameSimulation::Action choose(const GameSimulation& sim, GameRandom&) override {
+        return autopilot.choose(sim);
+    }
+};
+
+// Walks a Hamiltonian cycle with shortcuts; fills the board, so it gives the
+// longest possible snake for stress tests and benchmarks
+class HamiltonPolicy : public BotPolicy {
+private:
+    HamiltonianSolver solver;
+
+public:
+    const char* getName() const override { return "hamilton"; }
+
+    void begin(const GameSimulation& sim) override {
+        solver.begin(sim);
+    }
+
+    GameSimulation::Action choose(const GameSimulation& sim, GameRandom&) override {
+        return solver.choose(sim);
+    }
+};
+
+// Builds a policy by its command line name, or returns null if unknown
+inline std::unique_ptr<BotPolicy> createPolicy(const std::string& name) {
+    if (name == "random") return std::unique_ptr<BotPolicy>(new RandomPolicy());
+    if (name == "greedy") return std::unique_ptr<BotPolicy>(new GreedyPolicy());
+    if (name == "autopilot") return std::unique_ptr<BotPolicy>(new AutopilotPolicy());
+    if (name == "hamilton") return std::unique_ptr<BotPolicy>(new HamiltonPolicy());
+    return std::unique_ptr<BotPolicy>();
+}
+
+inline const char* policyNames() {
+    return "random, greedy, autopilot, hamilton";
+}
+
+#endif // BOTPOLICY_H
\ No newline at end of file
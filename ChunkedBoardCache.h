@@ -0,0 +1,274 @@
+#ifndef CHUNKEDBOARDCACHE_H
+#define CHUNKEDBOARDCACHE_H
+
+#include <SFML/Graphics.hpp>
+#include "GameSimulation.h"
+#include "FrameStats.h"
+#include <vector>
+#include <cmath>
+
+// Off-screen copy of the board for the classic window. The checkerboard and
+// every settled body segment (all but the sliding head and tail) live in one
+// sf::RenderTexture split into square chunks of cells. A normal tick only
+// changes the cells around the two ends, so only the chunks holding the old
+// and new head, tail and previous tail are redrawn, all of them in a single
+// draw into the texture; a Level 3 shrink redraws only the chunks along the
+// new edge, where the clamped segments pile up. A loaded level's walls are
+// baked in with the checkerboard, so they cost nothing after the first
+// frame. The screen then gets the texture in one draw plus one small array
+// with the head, the tail and the pickups.
+class ChunkedBoardCache {
+private:
+    static const int chunkSide = 4; // In cells
+    static const size_t circleSegments = 16;
+
+    sf::RenderTexture texture;
+    sf::Sprite sprite;
+    sf::VertexArray redraw;  // Cells of the dirty chunks, rebuilt per sync
+    sf::VertexArray moving;  // Head, tail and pickups, rebuilt per frame
+    std::vector<unsigned char> dirty;
+    std::vector<int> dirtyChunks;
+    int chunkCols;
+    int chunkRows;
+    int textureCols; // Board size the texture was created for
+    int textureRows;
+    bool failed;     // No render texture on this machine; never retried
+
+    bool built;
+    sf::Color builtColor1;
+    sf::Color builtColor2;
+    sf::Color builtBodyColor;
+    sf::Color builtObstacleColor;
+    unsigned knownRevision;
+    unsigned long long knownTicks;
+    int knownCols;
+    int knownRows;
+    Position knownHead;
+    Position knownTail;
+    Position knownPreviousTail;
+
+    float cellSize;
+    sf::Vector2f origin;
+    sf::Vector2f unitCircle[circleSegments];
+
+    void addQuad(sf::VertexArray& target, const sf::Vector2f& topLeft, float size, const sf::Color& color) {
+        sf::Vector2f topRight(topLeft.x + size, topLeft.y);
+        sf::Vector2f bottomRight(topLeft.x + size, topLeft.y + size);
+        sf::Vector2f bottomLeft(topLeft.x, topLeft.y + size);
+        target.append(sf::Vertex(topLeft, color));
+        target.append(sf::Vertex(topRight, color));
+        target.append(sf::Vertex(bottomRight, color));
+        target.append(sf::Vertex(topLeft, color));
+        target.append(sf::Vertex(bottomRight, color));
+        target.append(sf::Vertex(bottomLeft, color));
+    }
+
+    // cell may be fractional while interpolating
+    void addSegment(sf::VertexArray& target, const sf::Vector2f& cell, const sf::Color& color) {
+        addQuad(target, sf::Vector2f(cell.x * cellSize + 1, cell.y * cellSize + 1), cellSize - 2, color);
+    }
+
+    static sf::Vector2f lerp(const Position& from, const Position& to, float alpha) {
+        return sf::Vector2f(from.x + (to.x - from.x) * alpha, from.y + (to.y - from.y) * alpha);
+    }
+
+    void markChunk(int chunkX, int chunkY) {
+        if (chunkX < 0 || chunkX >= chunkCols || chunkY < 0 || chunkY >= chunkRows) return;
+        int index = chunkY * chunkCols + chunkX;
+        if (dirty[index]) return;
+        dirty[index] = 1;
+        dirtyChunks.push_back(index);
+    }
+
+    void markCell(const Position& cell) {
+        markChunk(cell.x / chunkSide, cell.y / chunkSide);
+    }
+
+    void markAll() {
+        for (int y = 0; y < chunkRows; ++y) {
+            for (int x = 0; x < chunkCols; ++x) markChunk(x, y);
+        }
+    }
+
+    // After a shrink from knownCols x knownRows: the chunks crossed by the
+    // columns and rows between the new edge and the old one
+    void markBorder(int cols, int rows) {
+        for (int x = (cols - 1) / chunkSide; x <= (knownCols - 1) / chunkSide; ++x) {
+            for (int y = 0; y <= (knownRows - 1) / chunkSide; ++y) markChunk(x, y);
+        }
+        for (int y = (rows - 1) / chunkSide; y <= (knownRows - 1) / chunkSide; ++y) {
+            for (int x = 0; x <= (knownCols - 1) / chunkSide; ++x) markChunk(x, y);
+        }
+    }
+
+    void markEnds() {
+        markCell(knownHead);
+        markCell(knownTail);
+        markCell(knownPreviousTail);
+    }
+
+    void rememberEnds(const Snake& snake) {
+        knownHead = snake.getHead();
+        knownTail = snake.getBody().back();
+        knownPreviousTail = snake.getPreviousTail();
+    }
+
+    // A cell belongs in the texture if it holds a segment other than the
+    // ones drawn sliding each frame
+    static bool isSettled(const Snake& snake, const Position& cell) {
+        int count = snake.getOccupancy().countAt(cell);
+        if (count == 0) return false;
+        const SnakeBody& body = snake.getBody();
+        int sliding = (cell == body.front() ? 1 : 0) + (body.size() >= 2 && cell == body.back() ? 1 : 0);
+        return count > sliding;
+    }
+
+    void renderDirty(const GameSimulation& sim, FrameStats& stats) {
+        if (dirtyChunks.empty()) return;
+        const Snake& snake = sim.getSnake();
+        const OccupancyGrid& occupied = snake.getOccupancy();
+        bool walls = sim.hasObstacles();
+        int cols = sim.getCols(), rows = sim.getRows();
+        redraw.clear();
+        for (size_t i = 0; i < dirtyChunks.size(); ++i) {
+            int chunkX = dirtyChunks[i] % chunkCols, chunkY = dirtyChunks[i] / chunkCols;
+            dirty[dirtyChunks[i]] = 0;
+            int right = std::min(cols, (chunkX + 1) * chunkSide);
+            int bottom = std::min(rows, (chunkY + 1) * chunkSide);
+            // Cells past the edge are never shown, so they are left stale
+            for (int y = chunkY * chunkSide; y < bottom; ++y) {
+                for (int x = chunkX * chunkSide; x < right; ++x) {
+                    Position cell{ x, y };
+                    addQuad(redraw, sf::Vector2f(x * cellSize, y * cellSize), cellSize,
+                        walls && occupied.isObstacle(cell) ? builtObstacleColor : (x + y) % 2 == 0 ? builtColor1 : builtColor2);
+                    if (isSettled(snake, cell)) {
+                        addSegment(redraw, sf::Vector2f(static_cast<float>(x), static_cast<float>(y)), builtBodyColor);
+                    }
+                }
+            }
+        }
+        dirtyChunks.clear();
+        stats.draw(texture, redraw);
+        texture.display();
+    }
+
+public:
+    ChunkedBoardCache(float cellSize, const sf::Vector2f& origin)
+        : redraw(sf::Triangles), moving(sf::Triangles), chunkCols(0), chunkRows(0), textureCols(0),
+          textureRows(0), failed(false), built(false), knownRevision(0), knownTicks(0), knownCols(0),
+          knownRows(0), knownHead{ 0, 0 }, knownTail{ 0, 0 }, knownPreviousTail{ 0, 0 },
+          cellSize(cellSize), origin(origin) {
+        const float pi = 3.14159265f;
+        for (size_t i = 0; i < circleSegments; ++i) {
+            float angle = 2 * pi * i / circleSegments;
+            unitCircle[i] = sf::Vector2f(std::cos(angle), std::sin(angle));
+        }
+    }
+
+    // Makes sure the texture can hold a cols x rows board. Returns false if
+    // render textures are unavailable or too small here, in which case the
+    // caller should draw the board some other way.
+    bool prepare(int cols, int rows) {
+        if (failed) return false;
+        if (cols <= textureCols && rows <= textureRows) return true;
+        unsigned width = static_cast<unsigned>(std::ceil(cols * cellSize));
+        unsigned height = static_cast<unsigned>(std::ceil(rows * cellSize));
+        if (width > sf::Texture::getMaximumSize() || height > sf::Texture::getMaximumSize() ||
+            !texture.create(width, height)) {
+            failed = true;
+            return false;
+        }
+        textureCols = cols;
+        textureRows = rows;
+        chunkCols = (cols + chunkSide - 1) / chunkSide;
+        chunkRows = (rows + chunkSide - 1) / chunkSide;
+        dirty.assign(static_cast<size_t>(chunkCols) * chunkRows, 0);
+        dirtyChunks.clear();
+        dirtyChunks.reserve(dirty.size());
+        sprite.setTexture(texture.getTexture());
+        built = false;
+        return true;
+    }
+
+    // Brings the texture up to date with the simulation. Call once per frame
+    // after prepare(); does nothing while the game is not advancing.
+    void sync(const GameSimulation& sim, const sf::Color& color1, const sf::Color& color2,
+        const sf::Color& bodyColor, const sf::Color& obstacleColor, FrameStats& stats) {
+        const Snake& snake = sim.getSnake();
+        int cols = sim.getCols(), rows = sim.getRows();
+        bool full = !built || color1 != builtColor1 || color2 != builtColor2 || bodyColor != builtBodyColor ||
+            obstacleColor != builtObstacleColor;
+        if (!full && sim.getBoardRevision() != knownRevision) {
+            // Level 3 shrink; anything else rewriting the body is a new game
+            if (cols < knownCols && rows < knownRows) markBorder(cols, rows);
+            else full = true;
+        }
+        if (!full && sim.getTicks() != knownTicks) {
+            // One tick moves only the ends; after several the cells in
+            // between are unknown
+            if (sim.getTicks() == knownTicks + 1) {
+                markEnds();
+                rememberEnds(snake);
+                markEnds();
+            }
+            else {
+                full = true;
+            }
+        }
+        if (full) {
+            markAll();
+            builtColor1 = color1;
+            builtColor2 = color2;
+            builtBodyColor = bodyColor;
+            builtObstacleColor = obstacleColor;
+            built = true;
+        }
+        knownRevision = sim.getBoardRevision();
+        knownTicks = sim.getTicks();
+        knownCols = cols;
+        knownRows = rows;
+        rememberEnds(snake);
+        renderDirty(sim, stats);
+        sprite.setTextureRect(sf::IntRect(0, 0, static_cast<int>(cols * cellSize), static_cast<int>(rows * cellSize)));
+    }
+
+    void beginMoving() {
+        moving.clear();
+    }
+
+    // Head and tail slide alpha of the way between the last two ticks, the
+    // same as EntityBatch::interpolate
+    void addSnakeEnds(const Snake& snake, float alpha, const sf::Color& headColor, const sf::Color& bodyColor) {
+        const SnakeBody& body = snake.getBody();
+        if (body.size() >= 2) {
+            addSegment(moving, lerp(snake.getPreviousTail(), body.back(), alpha), bodyColor);
+            addSegment(moving, lerp(body[1], body.front(), alpha), headColor);
+        }
+        else {
+            addSegment(moving, sf::Vector2f(static_cast<float>(body.front().x), static_cast<float>(body.front().y)), headColor);
+        }
+    }
+
+    void addPickup(const Position& cell, float radius, const sf::Color& color) {
+        sf::Vector2f center((cell.x + 0.5f) * cellSize, (cell.y + 0.5f) * cellSize);
+        for (size_t i = 0; i < circleSegments; ++i) {
+            size_t next = (i + 1) % circleSegments;
+            moving.append(sf::Vertex(center, color));
+            moving.append(sf::Vertex(center + unitCircle[i] * radius, color));
+            moving.append(sf::Vertex(center + unitCircle[next] * radius, color));
+        }
+    }
+
+    void drawBoard(sf::RenderTarget& target, FrameStats& stats) {
+        sprite.setPosition(origin);
+        stats.draw(target, sprite);
+    }
+
+    void drawMoving(sf::RenderTarget& target, FrameStats& stats) {
+        sf::RenderStates states;
+        states.transform.translate(origin.x, origin.y);
+        stats.draw(target, moving, states);
+    }
+};
+
+#endif // CHUNKEDBOARDCACHE_H
\ No newline at end of file
@@ -0,0 +1,145 @@
+#ifndef CULLEDBOARDRENDERER_H
+#define CULLEDBOARDRENDERER_H
+
+#include <SFML/Graphics.hpp>
+#include "Snake.h"
+#include "FrameStats.h"
+#include <cmath>
+
+// Renderer for boards seen through a BoardCamera. Nothing here walks the
+// whole board or the whole body: the checkerboard, with a loaded level's
+// walls, is built for the visible cells only (and only rebuilt when that
+// range, the colours or the game change), and the snake is drawn by asking
+// the occupancy grid about each visible cell, so a frame costs the same on
+// a 1000x1000 board with a 100k-segment snake as on a small one. Positions
+// are in world space, cell (x, y) at (x * cellSize, y * cellSize). Vertex
+// arrays keep their capacity between frames, so after the first few frames
+// nothing is allocated.
+class CulledBoardRenderer {
+private:
+    static const size_t circleSegments = 16;
+
+    sf::VertexArray board;
+    sf::VertexArray entities;
+    sf::IntRect builtRange;
+    sf::Color builtColor1;
+    sf::Color builtColor2;
+    sf::Color builtObstacleColor;
+    unsigned builtRevision;
+    bool built;
+    float cellSize;
+    sf::Vector2f unitCircle[circleSegments];
+
+    void addQuad(sf::VertexArray& target, const sf::Vector2f& topLeft, float size, const sf::Color& color) {
+        sf::Vector2f topRight(topLeft.x + size, topLeft.y);
+        sf::Vector2f bottomRight(topLeft.x + size, topLeft.y + size);
+        sf::Vector2f bottomLeft(topLeft.x, topLeft.y + size);
+        target.append(sf::Vertex(topLeft, color));
+        target.append(sf::Vertex(topRight, color));
+        target.append(sf::Vertex(bottomRight, color));
+        target.append(sf::Vertex(topLeft, color));
+        target.append(sf::Vertex(bottomRight, color));
+        target.append(sf::Vertex(bottomLeft, color));
+    }
+
+    // cell may be fractional while interpolating
+    void addSegment(const sf::Vector2f& cell, const sf::Color& color) {
+        addQuad(entities, sf::Vector2f(cell.x * cellSize + 1, cell.y * cellSize + 1), cellSize - 2, color);
+    }
+
+    static bool contains(const sf::IntRect& range, const Position& cell) {
+        return cell.x >= range.left && cell.x < range.left + range.width &&
+            cell.y >= range.top && cell.y < range.top + range.height;
+    }
+
+    static sf::Vector2f lerp(const Position& from, const Position& to, float alpha) {
+        return sf::Vector2f(from.x + (to.x - from.x) * alpha, from.y + (to.y - from.y) * alpha);
+    }
+
+public:
+    explicit CulledBoardRenderer(float cellSize)
+        : board(sf::Triangles), entities(sf::Triangles), builtRevision(0), built(false), cellSize(cellSize) {
+        const float pi = 3.14159265f;
+        for (size_t i = 0; i < circleSegments; ++i) {
+            float angle = 2 * pi * i / circleSegments;
+            unitCircle[i] = sf::Vector2f(std::cos(angle), std::sin(angle));
+        }
+    }
+
+    // visible comes from BoardCamera::getVisibleCells and revision from
+    // GameSimulation::getBoardRevision; cheap when nothing changed
+    void updateBoard(const sf::IntRect& visible, const sf::Color& color1, const sf::Color& color2,
+        const ObstacleMap& obstacles, const sf::Color& obstacleColor, unsigned revision) {
+        if (built && visible == builtRange && color1 == builtColor1 && color2 == builtColor2 &&
+            obstacleColor == builtObstacleColor && revision == builtRevision) return;
+        board.clear();
+        bool walls = !obstacles.empty();
+        for (int y = visible.top; y < visible.top + visible.height; ++y) {
+            for (int x = visible.left; x < visible.left + visible.width; ++x) {
+                addQuad(board, sf::Vector2f(x * cellSize, y * cellSize), cellSize,
+                    walls && obstacles.test(Position{ x, y }) ? obstacleColor : (x + y) % 2 == 0 ? color1 : color2);
+            }
+        }
+        builtRange = visible;
+        builtColor1 = color1;
+        builtColor2 = color2;
+        builtObstacleColor = obstacleColor;
+        builtRevision = revision;
+        built = true;
+    }
+
+    void beginEntities() {
+        entities.clear();
+    }
+
+    // Head and tail slide alpha of the way between the last two ticks, the
+    // same as EntityBatch::interpolate
+    void addSnake(const Snake& snake, const sf::IntRect& visible, float alpha,
+        const sf::Color& headColor, const sf::Color& bodyColor) {
+        const SnakeBody& body = snake.getBody();
+        const OccupancyGrid& occupied = snake.getOccupancy();
+        bool sliding = body.size() >= 2;
+        Position head = body.front();
+        Position tail = body.back();
+        for (int y = visible.top; y < visible.top + visible.height; ++y) {
+            for (int x = visible.left; x < visible.left + visible.width; ++x) {
+                Position cell{ x, y };
+                int count = occupied.countAt(cell);
+                if (count == 0) continue;
+                // The sliding head and tail quads stand in for their cells
+                if (sliding && count == 1 && (cell == head || cell == tail)) continue;
+                addSegment(sf::Vector2f(static_cast<float>(x), static_cast<float>(y)), bodyColor);
+            }
+        }
+        if (sliding) {
+            if (contains(visible, tail) || contains(visible, snake.getPreviousTail())) {
+                addSegment(lerp(snake.getPreviousTail(), tail, alpha), bodyColor);
+            }
+            addSegment(lerp(body[1], head, alpha), headColor);
+        }
+        else {
+            addSegment(sf::Vector2f(static_cast<float>(head.x), static_cast<float>(head.y)), headColor);
+        }
+    }
+
+    void addPickup(const sf::IntRect& visible, const Position& cell, float radius, const sf::Color& color) {
+        if (!contains(visible, cell)) return;
+        sf::Vector2f center((cell.x + 0.5f) * cellSize, (cell.y + 0.5f) * cellSize);
+        for (size_t i = 0; i < circleSegments; ++i) {
+            size_t next = (i + 1) % circleSegments;
+            entities.append(sf::Vertex(center, color));
+            entities.append(sf::Vertex(center + unitCircle[i] * radius, color));
+            entities.append(sf::Vertex(center + unitCircle[next] * radius, color));
+        }
+    }
+
+    void drawBoard(sf::RenderTarget& target, FrameStats& stats) {
+        stats.draw(target, board);
+    }
+
+    void drawEntities(sf::RenderTarget& target, FrameStats& stats) {
+        stats.draw(target, entities);
+    }
+};
+
+#endif // CULLEDBOARDRENDERER_H
\ No newline at end of file
@@ -0,0 +1,242 @@
+#ifndef ENTITYBATCH_H
+#define ENTITYBATCH_H
+
+#include <SFML/Graphics.hpp>
+#include "SnakeBody.h"
+#include "FrameStats.h"
+#include <vector>
+#include <cmath>
+
+// One persistent triangle buffer for everything that moves: the pickups
+// (apple, blue apple, bomb) followed by one quad per SnakeBody storage slot.
+// Because the quads mirror the ring buffer slots, a tick only rewrites the
+// new head, recolours the old head and blanks the old tail; the middle of
+// the body never changes. Everything is submitted in a single draw call, so
+// rendering cost does not depend on the snake's length.
+class EntityBatch {
+public:
+    enum Pickup { Apple, BlueApple, Bomb, PickupCount };
+
+private:
+    static const size_t circleSegments = 16;
+    static const size_t circleVertices = circleSegments * 3;
+    static const size_t quadVertices = 6;
+    static const size_t snakeBase = PickupCount * circleVertices;
+
+    struct PickupState {
+        bool visible;
+        sf::Vector2f center;
+        float radius;
+        sf::Color color;
+    };
+
+    std::vector<sf::Vertex> vertices;
+    sf::VertexBuffer buffer;
+    bool useBuffer;
+    bool fullUpload;
+    std::vector<size_t> dirtyRanges; // First vertex of each changed quad or circle
+    std::vector<size_t> dirtySizes;
+
+    PickupState pickups[PickupCount];
+    sf::Vector2f unitCircle[circleSegments];
+
+    float cellSize;
+    sf::Vector2f origin;
+    sf::Color headColor;
+    sf::Color bodyColor;
+
+    size_t slotCount;
+    size_t knownHeadSlot;
+    size_t knownLength;
+    bool synced;
+
+    void markDirty(size_t first, size_t count) {
+        if (fullUpload) return;
+        dirtyRanges.push_back(first);
+        dirtySizes.push_back(count);
+    }
+
+    // cell is in board cells and may be fractional while interpolating
+    void writeSegment(size_t slot, const sf::Vector2f& cell, const sf::Color& color) {
+        size_t v = snakeBase + slot * quadVertices;
+        float left = origin.x + cell.x * cellSize + 1;
+        float top = origin.y + cell.y * cellSize + 1;
+        float size = cellSize - 2;
+        sf::Vector2f topLeft(left, top), topRight(left + size, top);
+        sf::Vector2f bottomRight(left + size, top + size), bottomLeft(left, top + size);
+        vertices[v + 0] = sf::Vertex(topLeft, color);
+        vertices[v + 1] = sf::Vertex(topRight, color);
+        vertices[v + 2] = sf::Vertex(bottomRight, color);
+        vertices[v + 3] = sf::Vertex(topLeft, color);
+        vertices[v + 4] = sf::Vertex(bottomRight, color);
+        vertices[v + 5] = sf::Vertex(bottomLeft, color);
+        markDirty(v, quadVertices);
+    }
+
+    void writeSegment(size_t slot, const Position& position, const sf::Color& color) {
+        writeSegment(slot, sf::Vector2f(static_cast<float>(position.x), static_cast<float>(position.y)), color);
+    }
+
+    static sf::Vector2f lerp(const Position& from, const Position& to, float alpha) {
+        return sf::Vector2f(from.x + (to.x - from.x) * alpha, from.y + (to.y - from.y) * alpha);
+    }
+
+    // Collapses a slot to zero area so it rasterises nothing
+    void clearSegment(size_t slot) {
+        size_t v = snakeBase + slot * quadVertices;
+        for (size_t i = 0; i < quadVertices; ++i) {
+            vertices[v + i] = sf::Vertex(sf::Vector2f(0, 0), sf::Color::Transparent);
+        }
+        markDirty(v, quadVertices);
+    }
+
+    void writePickup(int index) {
+        const PickupState& pickup = pickups[index];
+        size_t v = index * circleVertices;
+        for (size_t i = 0; i < circleSegments; ++i) {
+            size_t next = (i + 1) % circleSegments;
+            if (pickup.visible) {
+                vertices[v + i * 3 + 0] = sf::Vertex(pickup.center, pickup.color);
+                vertices[v + i * 3 + 1] = sf::Vertex(pickup.center + unitCircle[i] * pickup.radius, pickup.color);
+                vertices[v + i * 3 + 2] = sf::Vertex(pickup.center + unitCircle[next] * pickup.radius, pickup.color);
+            }
+            else {
+                for (size_t k = 0; k < 3; ++k) {
+                    vertices[v + i * 3 + k] = sf::Vertex(sf::Vector2f(0, 0), sf::Color::Transparent);
+                }
+            }
+        }
+        markDirty(v, circleVertices);
+    }
+
+    void rebuildSnake(const SnakeBody& body) {
+        fullUpload = true;
+        dirtyRanges.clear();
+        dirtySizes.clear();
+        for (size_t slot = 0; slot < slotCount; ++slot) {
+            clearSegment(slot);
+        }
+        size_t headSlot = body.getHeadSlot();
+        for (size_t i = 0; i < body.size(); ++i) {
+            writeSegment((headSlot + i) % slotCount, body[i], i == 0 ? headColor : bodyColor);
+        }
+    }
+
+public:
+    EntityBatch(float cellSize, const sf::Vector2f& origin)
+        : buffer(sf::Triangles, sf::VertexBuffer::Stream), useBuffer(sf::VertexBuffer::isAvailable()),
+          fullUpload(true), cellSize(cellSize), origin(origin), slotCount(0), knownHeadSlot(0),
+          knownLength(0), synced(false) {
+        const float pi = 3.14159265f;
+        for (size_t i = 0; i < circleSegments; ++i) {
+            float angle = 2 * pi * i / circleSegments;
+            unitCircle[i] = sf::Vector2f(std::cos(angle), std::sin(angle));
+        }
+        for (int i = 0; i < PickupCount; ++i) {
+            pickups[i].visible = false;
+            pickups[i].radius = 0;
+        }
+        dirtyRanges.reserve(64);
+        dirtySizes.reserve(64);
+    }
+
+    // Forces the next syncSnake() to rewrite every slot (new snake, Level 3 clamp)
+    void invalidate() {
+        synced = false;
+    }
+
+    void setSnakeColors(const sf::Color& head, const sf::Color& body) {
+        if (head != headColor || body != bodyColor) {
+            headColor = head;
+            bodyColor = body;
+            synced = false;
+        }
+    }
+
+    void syncSnake(const SnakeBody& body) {
+        if (body.capacity() != slotCount) {
+            slotCount = body.capacity();
+            vertices.assign(snakeBase + slotCount * quadVertices, sf::Vertex(sf::Vector2f(0, 0), sf::Color::Transparent));
+            if (useBuffer) useBuffer = buffer.create(vertices.size());
+            for (int i = 0; i < PickupCount; ++i) writePickup(i);
+            fullUpload = true;
+            synced = false;
+        }
+
+        size_t headSlot = body.getHeadSlot();
+        size_t length = body.size();
+        if (synced) {
+            size_t added = (knownHeadSlot + slotCount - headSlot) % slotCount;
+            size_t oldTail = (knownHeadSlot + knownLength - 1) % slotCount;
+            size_t newTail = (headSlot + length - 1) % slotCount;
+            size_t removed = (oldTail + slotCount - newTail) % slotCount;
+            if (length == 0 || knownLength == 0 || added > length || removed > knownLength) {
+                synced = false;
+            }
+            else {
+                for (size_t i = 0; i < removed; ++i) {
+                    clearSegment((newTail + 1 + i) % slotCount);
+                }
+                for (size_t i = 0; i < added; ++i) {
+                    writeSegment((headSlot + i) % slotCount, body[i], i == 0 ? headColor : bodyColor);
+                }
+                if (added > 0 && added < length) {
+                    writeSegment((headSlot + added) % slotCount, body[added], bodyColor);
+                }
+            }
+        }
+        if (!synced) {
+            rebuildSnake(body);
+            synced = true;
+        }
+        knownHeadSlot = headSlot;
+        knownLength = length;
+    }
+
+    // Slides the head in from the cell behind it and the tail out of the cell
+    // it just left, alpha of the way between the last two ticks. Only those
+    // two quads change between ticks; call after syncSnake().
+    void interpolate(const SnakeBody& body, const Position& previousTail, float alpha) {
+        if (!synced || body.size() < 2) return;
+        size_t headSlot = body.getHeadSlot();
+        size_t tailSlot = (headSlot + body.size() - 1) % slotCount;
+        writeSegment(tailSlot, lerp(previousTail, body.back(), alpha), bodyColor);
+        writeSegment(headSlot, lerp(body[1], body[0], alpha), headColor);
+    }
+
+    void setPickup(Pickup index, bool visible, const sf::Vector2f& center, float radius, const sf::Color& color) {
+        PickupState& pickup = pickups[index];
+        if (pickup.visible == visible && (!visible ||
+            (pickup.center == center && pickup.radius == radius && pickup.color == color))) {
+            return;
+        }
+        pickup.visible = visible;
+        pickup.center = center;
+        pickup.radius = radius;
+        pickup.color = color;
+        if (!vertices.empty()) writePickup(index);
+    }
+
+    void draw(sf::RenderTarget& target, FrameStats& stats) {
+        if (vertices.empty()) return;
+        if (useBuffer) {
+            if (fullUpload) {
+                buffer.update(vertices.data());
+            }
+            else {
+                for (size_t i = 0; i < dirtyRanges.size(); ++i) {
+                    buffer.update(&vertices[dirtyRanges[i]], dirtySizes[i], static_cast<unsigned>(dirtyRanges[i]));
+                }
+            }
+            stats.draw(target, buffer);
+        }
+        else {
+            stats.draw(target, vertices.data(), vertices.size(), sf::Triangles);
+        }
+        fullUpload = false;
+        dirtyRanges.clear();
+        dirtySizes.clear();
+    }
+};
+
+#endif // ENTITYBATCH_H
@@ -0,0 +1,55 @@
+#ifndef FIXEDTIMESTEP_H
+#define FIXEDTIMESTEP_H
+
+#include <algorithm>
+
+// Turns variable frame times into a whole number of fixed simulation ticks.
+// Leftover time is carried to the next frame instead of being thrown away, so
+// a hitch never drops a move and the long-run tick rate is exactly one per
+// step. A frame runs at most maxStepsPerFrame ticks; anything beyond that is
+// discarded so a slow frame cannot snowball into ever longer catch-ups.
+class FixedTimestep {
+private:
+    double step;
+    double accumulator;
+    int maxStepsPerFrame;
+
+public:
+    FixedTimestep(double step, int maxStepsPerFrame = 5)
+        : step(step), accumulator(0.0), maxStepsPerFrame(maxStepsPerFrame) {}
+
+    // Changing the step (new level speed) starts the accumulator over
+    void setStep(double newStep) {
+        if (newStep != step) {
+            step = newStep;
+            accumulator = 0.0;
+        }
+    }
+
+    void reset() {
+        accumulator = 0.0;
+    }
+
+    // Returns how many ticks to run for a frame that took frameTime seconds
+    int advance(double frameTime) {
+        accumulator += frameTime;
+        int ticks = static_cast<int>(accumulator / step);
+        if (ticks > maxStepsPerFrame) {
+            ticks = maxStepsPerFrame;
+            accumulator = std::min(accumulator - ticks * step, step * 0.999);
+        }
+        else {
+            accumulator -= ticks * step;
+        }
+        return ticks;
+    }
+
+    // How far the next tick is along, 0..1, for interpolating the render
+    float getAlpha() const {
+        return static_cast<float>(accumulator / step);
+    }
+
+    double getStep() const { return step; }
+};
+
+#endif // FIXEDTIMESTEP_H
@@ -0,0 +1,199 @@
+#ifndef FRAMEPROFILER_H
+#define FRAMEPROFILER_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Profiling is on in debug builds and compiled out of release ones (NDEBUG)
+// unless SNAKE_PROFILING is set to 1 explicitly.
+#ifndef SNAKE_PROFILING
+#ifdef NDEBUG
+#define SNAKE_PROFILING 0
+#else
+#define SNAKE_PROFILING 1
+#endif
+#endif
+
+// Where each frame's time goes, kept for the last few hundred frames. A
+// frame is split into phases; the main loop marks the end of each phase as
+// it goes (PROFILE_MARK), so every nanosecond of the frame is charged to
+// exactly one phase, and a block of code can also be timed on its own with
+// PROFILE_SCOPE. Recording a frame is a few clock reads and array stores;
+// sorting only happens when a summary is asked for.
+class FrameProfiler {
+public:
+    enum Phase { Input, Simulation, BoardRender, EntityRender, HudRender, Display, phaseCount };
+
+    // Milliseconds, or counts for draw calls and vertices
+    struct Summary {
+        double p50;
+        double p99;
+        double max;
+    };
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    size_t windowFrames;
+    std::vector<std::uint32_t> phaseSamples[phaseCount]; // Nanoseconds, ring buffers
+    std::vector<std::uint32_t> frameSamples;
+    std::vector<std::uint32_t> drawCallSamples;
+    std::vector<std::uint32_t> vertexSamples;
+    std::uint64_t current[phaseCount]; // This frame so far
+    bool used[phaseCount];
+    unsigned long long frames;
+    Clock::time_point frameStart;
+    Clock::time_point lastMark;
+    mutable std::vector<std::uint32_t> scratch;
+
+    static std::uint32_t clampNanoseconds(std::uint64_t nanoseconds) {
+        return static_cast<std::uint32_t>(std::min<std::uint64_t>(nanoseconds, 0xFFFFFFFFu));
+    }
+
+    static std::uint64_t since(Clock::time_point start, Clock::time_point end) {
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+    }
+
+    Summary summarize(const std::vector<std::uint32_t>& samples, double scale) const {
+        Summary summary = { 0, 0, 0 };
+        size_t count = static_cast<size_t>(std::min<unsigned long long>(frames, windowFrames));
+        if (count == 0) return summary;
+        scratch.assign(samples.begin(), samples.begin() + count);
+        size_t p50 = (count - 1) / 2;
+        size_t p99 = (count - 1) * 99 / 100;
+        std::nth_element(scratch.begin(), scratch.begin() + p50, scratch.end());
+        summary.p50 = scratch[p50] * scale;
+        std::nth_element(scratch.begin() + p50, scratch.begin() + p99, scratch.end());
+        summary.p99 = scratch[p99] * scale;
+        summary.max = *std::max_element(scratch.begin() + p99, scratch.end()) * scale;
+        return summary;
+    }
+
+public:
+    explicit FrameProfiler(size_t windowFrames = 512)
+        : windowFrames(windowFrames), frameSamples(windowFrames), drawCallSamples(windowFrames),
+          vertexSamples(windowFrames), frames(0) {
+        for (int i = 0; i < phaseCount; ++i) {
+            phaseSamples[i].assign(windowFrames, 0);
+            current[i] = 0;
+            used[i] = false;
+        }
+        scratch.reserve(windowFrames);
+        frameStart = lastMark = Clock::now();
+    }
+
+    static const char* phaseName(Phase phase) {
+        static const char* names[phaseCount] = { "input", "simulation", "board", "entities", "hud", "display" };
+        return names[phase];
+    }
+
+    void beginFrame() {
+        for (int i = 0; i < phaseCount; ++i) current[i] = 0;
+        frameStart = lastMark = Clock::now();
+    }
+
+    // Charges the time since the previous mark (or the frame start) to phase
+    void mark(Phase phase) {
+        Clock::time_point now = Clock::now();
+        add(phase, since(lastMark, now));
+        lastMark = now;
+    }
+
+    void add(Phase phase, std::uint64_t nanoseconds) {
+        current[phase] += nanoseconds;
+        used[phase] = true;
+    }
+
+    void endFrame(unsigned drawCalls, unsigned vertices) {
+        size_t slot = static_cast<size_t>(frames % windowFrames);
+        for (int i = 0; i < phaseCount; ++i) phaseSamples[i][slot] = clampNanoseconds(current[i]);
+        frameSamples[slot] = clampNanoseconds(since(frameStart, Clock::now()));
+        drawCallSamples[slot] = drawCalls;
+        vertexSamples[slot] = vertices;
+        ++frames;
+    }
+
+    unsigned long long getFrames() const { return frames; }
+    bool hasSamples(Phase phase) const { return used[phase]; }
+
+    Summary summarize(Phase phase) const { return summarize(phaseSamples[phase], 1e-6); }
+    Summary summarizeFrame() const { return summarize(frameSamples, 1e-6); }
+    Summary summarizeDrawCalls() const { return summarize(drawCallSamples, 1.0); }
+    Summary summarizeVertices() const { return summarize(vertexSamples, 1.0); }
+
+    // Plain text table of every phase in use, for consoles and logs. Times
+    // are in microseconds, since a headless tick is well under one.
+    std::string report(const char* frameName = "frame") const {
+#if SNAKE_PROFILING
+        std::string text;
+        char line[96];
+        std::snprintf(line, sizeof(line), "%-12s %10s %10s %10s   (last %llu of %llu)\n", "us", "p50", "p99", "max",
+            std::min<unsigned long long>(frames, windowFrames), frames);
+        text += line;
+        for (int i = 0; i < phaseCount; ++i) {
+            if (!used[i]) continue;
+            Summary summary = summarize(static_cast<Phase>(i));
+            std::snprintf(line, sizeof(line), "%-12s %10.2f %10.2f %10.2f\n", phaseName(static_cast<Phase>(i)),
+                summary.p50 * 1000, summary.p99 * 1000, summary.max * 1000);
+            text += line;
+        }
+        Summary total = summarizeFrame();
+        std::snprintf(line, sizeof(line), "%-12s %10.2f %10.2f %10.2f\n", frameName,
+            total.p50 * 1000, total.p99 * 1000, total.max * 1000);
+        text += line;
+        Summary draws = summarizeDrawCalls();
+        if (draws.max > 0) {
+            Summary vertices = summarizeVertices();
+            std::snprintf(line, sizeof(line), "%-12s %10.0f %10.0f %10.0f\n", "draw calls", draws.p50, draws.p99, draws.max);
+            text += line;
+            std::snprintf(line, sizeof(line), "%-12s %10.0f %10.0f %10.0f\n", "vertices", vertices.p50, vertices.p99, vertices.max);
+            text += line;
+        }
+        return text;
+#else
+        (void)frameName;
+        return "Profiling is compiled out of this build (define SNAKE_PROFILING=1 to keep it)\n";
+#endif
+    }
+};
+
+// Adds the time from construction to destruction to a phase
+class ScopedPhaseTimer {
+private:
+    FrameProfiler& profiler;
+    FrameProfiler::Phase phase;
+    std::chrono::steady_clock::time_point start;
+
+public:
+    ScopedPhaseTimer(FrameProfiler& profiler, FrameProfiler::Phase phase)
+        : profiler(profiler), phase(phase), start(std::chrono::steady_clock::now()) {}
+
+    ~ScopedPhaseTimer() {
+        profiler.add(phase, static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count()));
+    }
+
+    ScopedPhaseTimer(const ScopedPhaseTimer&) = delete;
+    ScopedPhaseTimer& operator=(const ScopedPhaseTimer&) = delete;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+#if SNAKE_PROFILING
+#define PROFILE_BEGIN_FRAME(profiler) (profiler).beginFrame()
+#define PROFILE_MARK(profiler, phase) (profiler).mark(phase)
+#define PROFILE_SCOPE(profiler, phase) ScopedPhaseTimer PROFILE_CONCAT(profileScope, __LINE__)(profiler, phase)
+#define PROFILE_END_FRAME(profiler, drawCalls, vertices) (profiler).endFrame(drawCalls, vertices)
+#else
+#define PROFILE_BEGIN_FRAME(profiler) ((void)0)
+#define PROFILE_MARK(profiler, phase) ((void)0)
+#define PROFILE_SCOPE(profiler, phase) ((void)0)
+#define PROFILE_END_FRAME(profiler, drawCalls, vertices) ((void)0)
+#endif
+
+#endif // FRAMEPROFILER_H
\ No newline at end of file
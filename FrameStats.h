@@ -0,0 +1,96 @@
+#ifndef FRAMESTATS_H
+#define FRAMESTATS_H
+
+#include <SFML/Graphics.hpp>
+#include <string>
+
+// Counts the draw calls and vertices submitted for one frame. Draws routed
+// through here are forwarded to the target unchanged; the totals of the last
+// finished frame are what gets reported. endFrame() closes a frame, right
+// after it is displayed. Shapes, sprites and texts are counted by the
+// vertices SFML builds for them; any other drawable counts as a draw call
+// with no vertices.
+class FrameStats {
+private:
+    unsigned drawCalls;
+    unsigned vertices;
+    unsigned lastDrawCalls;
+    unsigned lastVertices;
+
+public:
+    FrameStats() : drawCalls(0), vertices(0), lastDrawCalls(0), lastVertices(0) {}
+
+    void endFrame() {
+        lastDrawCalls = drawCalls;
+        lastVertices = vertices;
+        drawCalls = 0;
+        vertices = 0;
+    }
+
+    void draw(sf::RenderTarget& target, const sf::Drawable& drawable,
+              const sf::RenderStates& states = sf::RenderStates::Default) {
+        ++drawCalls;
+        target.draw(drawable, states);
+    }
+
+    // A fan for the fill, plus a strip for the outline when there is one
+    void draw(sf::RenderTarget& target, const sf::Shape& shape,
+              const sf::RenderStates& states = sf::RenderStates::Default) {
+        ++drawCalls;
+        size_t points = shape.getPointCount();
+        vertices += static_cast<unsigned>(points + 2);
+        if (shape.getOutlineThickness() != 0) vertices += static_cast<unsigned>((points + 1) * 2);
+        target.draw(shape, states);
+    }
+
+    void draw(sf::RenderTarget& target, const sf::Sprite& sprite,
+              const sf::RenderStates& states = sf::RenderStates::Default) {
+        ++drawCalls;
+        vertices += 4;
+        target.draw(sprite, states);
+    }
+
+    // Two triangles per visible glyph, twice over with an outline
+    void draw(sf::RenderTarget& target, const sf::Text& text,
+              const sf::RenderStates& states = sf::RenderStates::Default) {
+        ++drawCalls;
+        const sf::String& string = text.getString();
+        unsigned glyphs = 0;
+        for (size_t i = 0; i < string.getSize(); ++i) {
+            sf::Uint32 character = string[i];
+            if (character != ' ' && character != '\t' && character != '\n') ++glyphs;
+        }
+        vertices += glyphs * (text.getOutlineThickness() != 0 ? 12 : 6);
+        target.draw(text, states);
+    }
+
+    void draw(sf::RenderTarget& target, const sf::VertexArray& array,
+              const sf::RenderStates& states = sf::RenderStates::Default) {
+        ++drawCalls;
+        vertices += static_cast<unsigned>(array.getVertexCount());
+        target.draw(array, states);
+    }
+
+    void draw(sf::RenderTarget& target, const sf::VertexBuffer& buffer,
+              const sf::RenderStates& states = sf::RenderStates::Default) {
+        ++drawCalls;
+        vertices += static_cast<unsigned>(buffer.getVertexCount());
+        target.draw(buffer, states);
+    }
+
+    void draw(sf::RenderTarget& target, const sf::Vertex* vertexData, size_t count, sf::PrimitiveType type,
+              const sf::RenderStates& states = sf::RenderStates::Default) {
+        ++drawCalls;
+        vertices += static_cast<unsigned>(count);
+        target.draw(vertexData, count, type, states);
+    }
+
+    unsigned getDrawCalls() const { return lastDrawCalls; }
+    unsigned getVertices() const { return lastVertices; }
+
+    std::string summary() const {
+        return "Draw calls: " + std::to_string(lastDrawCalls) + "\nVertices: " + std::to_string(lastVertices);
+    }
+};
+
+#endif // FRAMESTATS_H
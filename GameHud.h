@@ -0,0 +1,195 @@
+#ifndef GAMEHUD_H
+#define GAMEHUD_H
+
+#include <SFML/Graphics.hpp>
+#include "ScoringSystem.h"
+#include "FrameStats.h"
+#include <sstream>
+#include <string>
+
+// Everything drawn around the board while playing: the instructions, the
+// header bar and the score and apple counters. All of it is laid out once
+// when the font arrives. The instructions are written from the rules being
+// played, so a loaded level shows its own scores, and rewritten only when
+// those rules change. The counter labels never change, and the numbers after
+// them are quads cut from ten digit glyphs looked up once, rebuilt only when
+// a value changes. An unchanged frame does no text layout at all.
+class GameHud {
+private:
+    static const unsigned counterSize = 24;
+
+    struct Counter {
+        sf::Text label;
+        sf::VertexArray digits;
+        int shown;
+    };
+
+    const sf::Font* font;
+    sf::Text instructions;
+    sf::VertexArray header;
+    sf::CircleShape appleIcon;
+    Counter score;
+    Counter apples;
+    sf::Glyph digitGlyphs[10];
+
+    // The rules the instructions were written for
+    int smallAppleScore;
+    int bigAppleScore;
+    bool bombs;
+    float wallShrinkInterval; // 0 when the walls stay put
+
+    static void appendQuad(sf::VertexArray& target, const sf::Vector2f& topLeft, const sf::Vector2f& size, const sf::Color& color) {
+        target.append(sf::Vertex(topLeft, color));
+        target.append(sf::Vertex(sf::Vector2f(topLeft.x + size.x, topLeft.y), color));
+        target.append(sf::Vertex(topLeft + size, color));
+        target.append(sf::Vertex(sf::Vector2f(topLeft.x, topLeft.y + size.y), color));
+    }
+
+    void setUpText(sf::Text& text, unsigned size, const sf::String& string, float x, float y) {
+        text.setFont(*font);
+        text.setCharacterSize(size);
+        text.setFillColor(sf::Color(255, 215, 0));
+        text.setStyle(sf::Text::Bold);
+        text.setString(string);
+        text.setPosition(x, y);
+    }
+
+    // The same quad sf::Text makes for a glyph, with SFML's one pixel padding
+    static void appendGlyph(sf::VertexArray& target, float x, float y, const sf::Glyph& glyph, const sf::Color& color) {
+        const float padding = 1.0f;
+        float left = glyph.bounds.left - padding;
+        float top = glyph.bounds.top - padding;
+        float right = glyph.bounds.left + glyph.bounds.width + padding;
+        float bottom = glyph.bounds.top + glyph.bounds.height + padding;
+        float u1 = glyph.textureRect.left - padding;
+        float v1 = glyph.textureRect.top - padding;
+        float u2 = glyph.textureRect.left + glyph.textureRect.width + padding;
+        float v2 = glyph.textureRect.top + glyph.textureRect.height + padding;
+        target.append(sf::Vertex(sf::Vector2f(x + left, y + top), color, sf::Vector2f(u1, v1)));
+        target.append(sf::Vertex(sf::Vector2f(x + right, y + top), color, sf::Vector2f(u2, v1)));
+        target.append(sf::Vertex(sf::Vector2f(x + left, y + bottom), color, sf::Vector2f(u1, v2)));
+        target.append(sf::Vertex(sf::Vector2f(x + left, y + bottom), color, sf::Vector2f(u1, v2)));
+        target.append(sf::Vertex(sf::Vector2f(x + right, y + top), color, sf::Vector2f(u2, v1)));
+        target.append(sf::Vertex(sf::Vector2f(x + right, y + bottom), color, sf::Vector2f(u2, v2)));
+    }
+
+    // Lays the digits of value out right after the counter's label
+    void layOut(Counter& counter, int value) {
+        if (value == counter.shown) return;
+        counter.shown = value;
+        char digits[12];
+        int count = 0;
+        unsigned remaining = static_cast<unsigned>(value < 0 ? 0 : value);
+        do {
+            digits[count++] = static_cast<char>('0' + remaining % 10);
+            remaining /= 10;
+        } while (remaining > 0);
+
+        sf::Vector2f pen = counter.label.findCharacterPos(counter.label.getString().getSize());
+        float baseline = pen.y + counterSize;
+        sf::Color color = counter.label.getFillColor();
+        counter.digits.clear();
+        for (int i = count - 1; i >= 0; --i) {
+            if (i < count - 1) pen.x += font->getKerning(digits[i + 1], digits[i], counterSize);
+            const sf::Glyph& glyph = digitGlyphs[digits[i] - '0'];
+            appendGlyph(counter.digits, pen.x, baseline, glyph, color);
+            pen.x += glyph.advance;
+        }
+    }
+
+    static std::string points(int value) {
+        return "+" + std::to_string(value) + (value == 1 ? " point" : " points");
+    }
+
+    void writeInstructions() {
+        std::ostringstream text;
+        text << "Instructions:\n"
+            << "- Red Apple: " << points(smallAppleScore) << ",\n  grows snake by 1\n"
+            << "- Big Blue Apple: " << points(bigAppleScore) << ",\n  grows snake by 2\n";
+        if (bombs) text << "- Black Bomb: Game over\n";
+        if (wallShrinkInterval > 0) text << "- Walls shrink every " << wallShrinkInterval << "s\n";
+        text << "- Controls:\n"
+            << "  Arrow Keys: Move\n"
+            << "  A: Autopilot\n"
+            << "  P: Pause\n"
+            << "  R: Restart\n"
+            << "  ESC: Menu";
+        instructions.setString(text.str());
+    }
+
+    void drawCounter(sf::RenderTarget& target, FrameStats& stats, const Counter& counter) {
+        stats.draw(target, counter.label);
+        sf::RenderStates states;
+        states.texture = &font->getTexture(counterSize);
+        stats.draw(target, counter.digits, states);
+    }
+
+public:
+    GameHud() : font(nullptr), header(sf::Quads), smallAppleScore(1), bigAppleScore(2), bombs(false), wallShrinkInterval(0) {
+        score.digits.setPrimitiveType(sf::Triangles);
+        apples.digits.setPrimitiveType(sf::Triangles);
+        score.shown = apples.shown = -1;
+    }
+
+    // Builds every text; without a font the HUD draws nothing
+    void setFont(const sf::Font& hudFont) {
+        font = &hudFont;
+        setUpText(instructions, 20, "", 990, 50);
+        instructions.setLineSpacing(1.2f);
+        writeInstructions();
+
+        // Gradient bar with a one pixel outline around it, in one draw
+        header.clear();
+        header.append(sf::Vertex(sf::Vector2f(40, 5), sf::Color(20, 80, 20)));
+        header.append(sf::Vertex(sf::Vector2f(1000, 5), sf::Color(30, 90, 30)));
+        header.append(sf::Vertex(sf::Vector2f(40, 35), sf::Color(20, 80, 20)));
+        header.append(sf::Vertex(sf::Vector2f(1000, 35), sf::Color(30, 90, 30)));
+        sf::Color outline(139, 69, 19);
+        appendQuad(header, sf::Vector2f(39, 4), sf::Vector2f(962, 1), outline);
+        appendQuad(header, sf::Vector2f(39, 35), sf::Vector2f(962, 1), outline);
+        appendQuad(header, sf::Vector2f(39, 5), sf::Vector2f(1, 30), outline);
+        appendQuad(header, sf::Vector2f(1000, 5), sf::Vector2f(1, 30), outline);
+
+        appleIcon.setRadius(10);
+        appleIcon.setPosition(960 - 120, 10);
+
+        setUpText(score.label, counterSize, "Score: ", 50, 8);
+        setUpText(apples.label, counterSize, ": ", 960 - 100, 8);
+        for (int i = 0; i < 10; ++i) {
+            digitGlyphs[i] = font->getGlyph('0' + i, counterSize, true);
+        }
+        score.shown = apples.shown = -1;
+    }
+
+    // Cheap when the rules are the ones already shown; appleColor is the
+    // level's LevelColors::apple
+    void setRules(const ScoringSystem& rules, const sf::Color& appleColor) {
+        appleIcon.setFillColor(appleColor);
+        float shrink = rules.hasShrinkingWalls() ? rules.getWallShrinkInterval() : 0;
+        if (rules.getSmallAppleScore() == smallAppleScore && rules.getBigAppleScore() == bigAppleScore &&
+            rules.hasBombs() == bombs && shrink == wallShrinkInterval) return;
+        smallAppleScore = rules.getSmallAppleScore();
+        bigAppleScore = rules.getBigAppleScore();
+        bombs = rules.hasBombs();
+        wallShrinkInterval = shrink;
+        if (font) writeInstructions();
+    }
+
+    // Cheap when the values have not changed
+    void setCounters(int scoreValue, int appleValue) {
+        if (!font) return;
+        layOut(score, scoreValue);
+        layOut(apples, appleValue);
+    }
+
+    void draw(sf::RenderTarget& target, FrameStats& stats) {
+        if (!font) return;
+        stats.draw(target, instructions);
+        stats.draw(target, header);
+        drawCounter(target, stats, score);
+        stats.draw(target, appleIcon);
+        drawCounter(target, stats, apples);
+    }
+};
+
+#endif // GAMEHUD_H
\ No newline at end of file
@@ -0,0 +1,56 @@
+#ifndef GAMERANDOM_H
+#define GAMERANDOM_H
+
+#include <cstdint>
+
+// PCG32 (O'Neill, pcg-random.org): 64-bit state, 32-bit output, and a stream
+// selector so each kind of entity draws from its own independent sequence
+// off the same game seed. Everything here is plain integer arithmetic with
+// fixed widths, so a seed gives the same numbers on every compiler and CPU,
+// which std::uniform_int_distribution does not promise.
+class GameRandom {
+private:
+    std::uint64_t state;
+    std::uint64_t increment;
+
+public:
+    typedef std::uint32_t result_type;
+
+    GameRandom() { seed(0, 0); }
+    GameRandom(std::uint64_t seedValue, std::uint64_t stream) { seed(seedValue, stream); }
+
+    void seed(std::uint64_t seedValue, std::uint64_t stream) {
+        state = 0;
+        increment = (stream << 1) | 1u;
+        (*this)();
+        state += seedValue;
+        (*this)();
+    }
+
+    result_type operator()() {
+        std::uint64_t old = state;
+        state = old * 6364136223846793005ULL + increment;
+        std::uint32_t xorShifted = static_cast<std::uint32_t>(((old >> 18) ^ old) >> 27);
+        std::uint32_t rotation = static_cast<std::uint32_t>(old >> 59);
+        return (xorShifted >> rotation) | (xorShifted << ((32 - rotation) & 31));
+    }
+
+    // Unbiased integer in [0, bound) using Lemire's multiply-and-reject
+    std::uint32_t nextBelow(std::uint32_t bound) {
+        std::uint64_t product = static_cast<std::uint64_t>((*this)()) * bound;
+        std::uint32_t low = static_cast<std::uint32_t>(product);
+        if (low < bound) {
+            std::uint32_t threshold = (0u - bound) % bound;
+            while (low < threshold) {
+                product = static_cast<std::uint64_t>((*this)()) * bound;
+                low = static_cast<std::uint32_t>(product);
+            }
+        }
+        return static_cast<std::uint32_t>(product >> 32);
+    }
+
+    static result_type min() { return 0; }
+    static result_type max() { return 0xFFFFFFFFu; }
+};
+
+#endif // GAMERANDOM_H
@@ -0,0 +1,320 @@
+#ifndef GAMESIMULATION_H
+#define GAMESIMULATION_H
+
+#include "Position.h"
+#include "Snake.h"
+#include "Apple.h"
+#include "Bomb.h"
+#include "ScoringSystem.h"
+#include "LevelDefinition.h"
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+
+// The whole game without a window: snake, pickups, timers, scoring and the
+// Level 3 wall shrink. step() advances exactly one move, and every timer
+// advances by one move interval with it, so a run is the same whether it is
+// driven by the SFML frontend or by a headless loop as fast as it can go.
+// Nothing in here depends on SFML.
+//
+// Runs are reproducible: every random draw comes from GameRandom streams
+// seeded by reset(), and the timers count whole ticks instead of summing
+// floats, so the same seed and the same actions give the same game anywhere.
+//
+// Besides the three built-in levels, a game can be started from a
+// LevelDefinition loaded from a file. Its walls sit in the snake's occupancy
+// grid, so the collision and spawn checks a tick already makes cover them.
+class GameSimulation {
+public:
+    typedef ScoringSystem::Level Level;
+    enum class Action { None, Up, Down, Left, Right };
+    enum class Outcome { Running, HitWall, HitSelf, HitBomb, BoardFull };
+
+    static const int startCols = 23;
+    static const int startRows = 18;
+    static const int maxBoardSide = 1000;
+
+private:
+    // A loaded level's rules in the shape of LevelTraits, so one tick
+    // template reads either; these are only known at run time
+    struct LoadedRules {
+        int smallAppleScore;
+        int bigAppleScore;
+        bool hasBombs;
+        bool hasShrinkingWalls;
+    };
+
+    ScoringSystem rules;
+    LoadedRules loadedRules;
+    ObstacleMap obstacles; // Walls of a loaded level; empty for the built-in ones
+    Outcome (GameSimulation::*stepFunction)(Action); // stepLevel<N> or stepLoaded for the level being played
+    int boardCols; // Size every reset starts from
+    int boardRows;
+    int cols;
+    int rows;
+    Snake snake;
+    Apple apple;
+    Apple blueApple;
+    Bomb bomb;
+    bool blueAppleVisible;
+    bool bombVisible;
+    std::uint64_t seed;
+
+    // Timers count ticks; the limits are the rules' second-based intervals
+    // converted once per level
+    unsigned blueAppleTimer;
+    unsigned blueAppleVisibleTimer;
+    unsigned bombTimer;
+    unsigned bombVisibleTimer;
+    unsigned wallShrinkTimer;
+    unsigned blueAppleIntervalTicks;
+    unsigned blueAppleVisibleTicks;
+    unsigned bombIntervalTicks;
+    unsigned bombVisibleTicks;
+    unsigned wallShrinkIntervalTicks;
+    int score;
+    int appleCount;
+    unsigned long long ticks;
+    unsigned boardRevision; // Bumped whenever the body is rewritten wholesale
+    Outcome outcome;
+
+    enum Stream : std::uint64_t { AppleStream = 1, BlueAppleStream = 2, BombStream = 3 };
+
+    // Smallest tick count whose elapsed time reaches the interval
+    unsigned ticksFor(float seconds) const {
+        return static_cast<unsigned>(std::ceil(seconds / rules.getMoveInterval() - 0.0001f));
+    }
+
+    void shrinkWalls() {
+        if (cols <= 5 || rows <= 5) return;
+        cols--;
+        rows--;
+        snake.clampTo(cols, rows);
+        ++boardRevision;
+        const OccupancyGrid& occupied = snake.getOccupancy();
+        if (apple.getPosition().x >= cols || apple.getPosition().y >= rows) {
+            if (!apple.respawn(occupied)) outcome = Outcome::BoardFull;
+        }
+        if (blueApple.getPosition().x >= cols || blueApple.getPosition().y >= rows) {
+            blueAppleVisible = blueAppleVisible && blueApple.respawn(occupied);
+        }
+        if (bomb.getPosition().x >= cols || bomb.getPosition().y >= rows) {
+            bombVisible = bombVisible && bomb.respawn(occupied);
+        }
+    }
+
+    // One tick under the given rules. For LevelTraits<N> the rules are
+    // compile-time constants, so each built-in level's instantiation has its
+    // branches folded away.
+    template <typename Rules>
+    Outcome stepWith(Action action, const Rules& level) {
+        steer(action);
+
+        ++ticks;
+        ++blueAppleTimer;
+        if (level.hasBombs) {
+            ++bombTimer;
+        }
+        if (level.hasShrinkingWalls) {
+            ++wallShrinkTimer;
+        }
+        if (blueAppleVisible) {
+            if (++blueAppleVisibleTimer >= blueAppleVisibleTicks) {
+                blueAppleVisible = false;
+                blueAppleVisibleTimer = 0;
+            }
+        }
+        if (bombVisible) {
+            if (++bombVisibleTimer >= bombVisibleTicks) {
+                bombVisible = false;
+                bombVisibleTimer = 0;
+            }
+        }
+
+        if (level.hasShrinkingWalls && wallShrinkTimer >= wallShrinkIntervalTicks) {
+            shrinkWalls();
+            wallShrinkTimer = 0;
+            if (outcome != Outcome::Running) return outcome;
+        }
+
+        snake.update();
+
+        if (snake.checkWallCollision(cols, rows)) {
+            return outcome = Outcome::HitWall;
+        }
+        if (snake.checkSelfCollision()) {
+            return outcome = snake.hitObstacle() ? Outcome::HitWall : Outcome::HitSelf;
+        }
+
+        if (snake.getHead() == apple.getPosition()) {
+            snake.grow();
+            score += level.smallAppleScore;
+            appleCount += 1;
+            // No free cell left means the snake has filled the board
+            if (!apple.respawn(snake.getOccupancy())) {
+                return outcome = Outcome::BoardFull;
+            }
+        }
+
+        if (blueAppleVisible && snake.getHead() == blueApple.getPosition()) {
+            snake.grow();
+            snake.grow();
+            score += level.bigAppleScore;
+            appleCount += 1;
+            blueAppleVisible = false;
+            blueAppleVisibleTimer = 0;
+        }
+
+        if (bombVisible && snake.getHead() == bomb.getPosition()) {
+            return outcome = Outcome::HitBomb;
+        }
+
+        if (!blueAppleVisible && blueAppleTimer >= blueAppleIntervalTicks) {
+            blueAppleVisible = blueApple.respawn(snake.getOccupancy());
+            blueAppleVisibleTimer = 0;
+            blueAppleTimer = 0;
+        }
+
+        if (!bombVisible && level.hasBombs && bombTimer >= bombIntervalTicks) {
+            bombVisible = bomb.respawn(snake.getOccupancy());
+            bombVisibleTimer = 0;
+            bombTimer = 0;
+        }
+
+        return outcome;
+    }
+
+    template <int N>
+    Outcome stepLevel(Action action) {
+        return stepWith(action, LevelTraits<N>());
+    }
+
+    Outcome stepLoaded(Action action) {
+        return stepWith(action, loadedRules);
+    }
+
+    void start(std::uint64_t gameSeed) {
+        cols = boardCols;
+        rows = boardRows;
+        seed = gameSeed;
+        apple.seed(seed, AppleStream);
+        blueApple.seed(seed, BlueAppleStream);
+        bomb.seed(seed, BombStream);
+        snake = Snake(cols, rows, obstacles.empty() ? nullptr : &obstacles);
+        apple.respawn(snake.getOccupancy());
+        blueApple.respawn(snake.getOccupancy());
+        bomb.respawn(snake.getOccupancy());
+        blueAppleVisible = false;
+        bombVisible = false;
+        blueAppleTimer = 0;
+        blueAppleVisibleTimer = 0;
+        bombTimer = 0;
+        bombVisibleTimer = 0;
+        wallShrinkTimer = 0;
+        blueAppleIntervalTicks = ticksFor(rules.getBlueAppleInterval());
+        blueAppleVisibleTicks = ticksFor(rules.getBlueAppleVisibleDuration());
+        bombIntervalTicks = ticksFor(rules.getBombInterval());
+        bombVisibleTicks = ticksFor(rules.getBombVisibleDuration());
+        wallShrinkIntervalTicks = ticksFor(rules.getWallShrinkInterval());
+        score = 0;
+        appleCount = 0;
+        ticks = 0;
+        ++boardRevision;
+        outcome = Outcome::Running;
+    }
+
+public:
+    GameSimulation()
+        : rules(Level::Level1), loadedRules(), stepFunction(&GameSimulation::stepLevel<1>), boardCols(startCols),
+          boardRows(startRows), cols(startCols), rows(startRows), snake(startCols, startRows), boardRevision(0) {
+        reset(Level::Level1, 0);
+    }
+
+    // Takes effect at the next reset(); never smaller than the classic board
+    void setBoardSize(int newCols, int newRows) {
+        boardCols = std::min(std::max(newCols, static_cast<int>(startCols)), static_cast<int>(maxBoardSide));
+        boardRows = std::min(std::max(newRows, static_cast<int>(startRows)), static_cast<int>(maxBoardSide));
+    }
+
+    void reset(Level level, std::uint64_t gameSeed) {
+        rules = ScoringSystem(level);
+        switch (level) {
+        case Level::Level2: stepFunction = &GameSimulation::stepLevel<2>; break;
+        case Level::Level3: stepFunction = &GameSimulation::stepLevel<3>; break;
+        default: stepFunction = &GameSimulation::stepLevel<1>; break;
+        }
+        if (!obstacles.empty()) obstacles = ObstacleMap();
+        start(gameSeed);
+    }
+
+    // Starts a game of a loaded level. Its board size replaces the one from
+    // setBoardSize(), and later resets of this kind reuse the wall buffer.
+    void reset(const LevelDefinition& level, std::uint64_t gameSeed) {
+        rules = ScoringSystem(level);
+        loadedRules.smallAppleScore = level.smallAppleScore;
+        loadedRules.bigAppleScore = level.bigAppleScore;
+        loadedRules.hasBombs = level.hasBombs;
+        loadedRules.hasShrinkingWalls = level.hasShrinkingWalls;
+        stepFunction = &GameSimulation::stepLoaded;
+        boardCols = level.cols;
+        boardRows = level.rows;
+        obstacles = level.obstacles;
+        start(gameSeed);
+    }
+
+    // Applied immediately, like a key press; the snake still refuses to reverse
+    void steer(Action action) {
+        switch (action) {
+        case Action::Up: snake.setDirection(0, -1); break;
+        case Action::Down: snake.setDirection(0, 1); break;
+        case Action::Left: snake.setDirection(-1, 0); break;
+        case Action::Right: snake.setDirection(1, 0); break;
+        default: break;
+        }
+    }
+
+    Outcome step(Action action = Action::None) {
+        if (outcome != Outcome::Running) return outcome;
+        return (this->*stepFunction)(action);
+    }
+
+    // True if moving the head onto this cell would end the game right now
+    bool isBlocked(const Position& cell) const {
+        return cell.x < 0 || cell.x >= cols || cell.y < 0 || cell.y >= rows ||
+            snake.getOccupancy().isOccupied(cell) ||
+            (bombVisible && cell == bomb.getPosition());
+    }
+
+    Level getLevel() const { return rules.getLevel(); }
+    const ScoringSystem& getRules() const { return rules; }
+    float getMoveInterval() const { return rules.getMoveInterval(); }
+    int getBoardCols() const { return boardCols; }
+    int getBoardRows() const { return boardRows; }
+    int getCols() const { return cols; }
+    int getRows() const { return rows; }
+    const Snake& getSnake() const { return snake; }
+    const ObstacleMap& getObstacles() const { return obstacles; }
+    bool hasObstacles() const { return !obstacles.empty(); }
+    Position getApple() const { return apple.getPosition(); }
+    Position getBlueApple() const { return blueApple.getPosition(); }
+    Position getBomb() const { return bomb.getPosition(); }
+    bool isBlueAppleVisible() const { return blueAppleVisible; }
+    // Moves within which the head can still eat the blue apple; 0 when hidden
+    unsigned getBlueAppleMovesLeft() const {
+        return blueAppleVisible ? blueAppleVisibleTicks - blueAppleVisibleTimer - 1 : 0;
+    }
+    bool isBombVisible() const { return bombVisible; }
+    // Moves within which the head would still run into the bomb; 0 when hidden
+    unsigned getBombMovesLeft() const {
+        return bombVisible ? bombVisibleTicks - bombVisibleTimer - 1 : 0;
+    }
+    int getScore() const { return score; }
+    int getAppleCount() const { return appleCount; }
+    unsigned long long getTicks() const { return ticks; }
+    std::uint64_t getSeed() const { return seed; }
+    unsigned getBoardRevision() const { return boardRevision; }
+    Outcome getOutcome() const { return outcome; }
+    bool isOver() const { return outcome != Outcome::Running; }
+};
+
+#endif // GAMESIMULATION_H
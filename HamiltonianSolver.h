@@ -0,0 +1,298 @@
+#ifndef HAMILTONIANSOLVER_H
+#define HAMILTONIANSOLVER_H
+
+#include "GameSimulation.h"
+#include "Autopilot.h"
+#include <algorithm>
+#include <vector>
+
+// Plays by walking a Hamiltonian cycle through every cell of the board, which
+// never runs into itself and so ends with the board completely full. The
+// cycle is a serpentine over columns 1.. with column 0 as the way back (or
+// the same turned sideways when the row count is odd), and it is rebuilt
+// whenever Level 3 shrinks the board. order holds each cell's place on the
+// cycle, so how far one cell is ahead of another is a single subtraction.
+//
+// While the body lies along the cycle in order, every cell between the head
+// and the tail (going forwards) is empty, so the head may cut ahead as long
+// as it lands before the tail; it does so towards the apple while the snake
+// is shorter than half the board, and at any length to jump over a bomb
+// lying on the way. Each decision then looks at four neighbours and nothing
+// else. A bomb that cannot be jumped is walked around: once, when it shows
+// up, a short search off the cycle looks for a cell from which following the
+// cycle again meets neither the body nor the bomb, and the walk is then
+// stepped along one cell per tick. After such a walk, and right after a start
+// or a Level 3 rebuild, the body may not lie in cycle order; until it does,
+// each decision costs O(length), re-checking the order and checking each of
+// the four neighbours against every segment. A board with no cycle (both
+// sides odd), a loaded level with walls, or no such walk hands the move to
+// the Autopilot, and whatever it answers, a move that would end the game is
+// swapped for any neighbour that does not.
+class HamiltonianSolver {
+private:
+    std::vector<int> order; // Place on the cycle, indexed y * cols + x
+    int cols;
+    int rows;
+    int cellCount;
+    bool hasCycle;
+    bool aligned; // Body known to lie along the cycle, head first
+    Autopilot fallback;
+
+    static const int maxDetour = 6;
+    // Ticks until the body leaves each cell, only where leaveStamp holds the
+    // current generation, so planning never clears the whole board
+    std::vector<int> leaveAt;
+    std::vector<unsigned> leaveStamp;
+    unsigned leaveGeneration;
+    std::vector<Position> trial; // Walk off the cycle being searched, one cell per tick
+    std::vector<Position> detour; // Walk being followed
+    size_t detourNext; // Index of the next cell of detour to step onto
+    unsigned long long detourTick; // Tick that step is due
+    unsigned long long bombPlanned; // Tick the last bomb planned around goes away
+
+    static int moveX(int move) { static const int dx[] = { 0, 0, -1, 1 }; return dx[move]; }
+    static int moveY(int move) { static const int dy[] = { -1, 1, 0, 0 }; return dy[move]; }
+
+    int orderOf(const Position& cell) const { return order[cell.y * cols + cell.x]; }
+
+    // Steps along the cycle from a to b
+    int ahead(int from, int to) const {
+        int steps = to - from;
+        return steps < 0 ? steps + cellCount : steps;
+    }
+
+    void build(int boardCols, int boardRows) {
+        cols = boardCols;
+        rows = boardRows;
+        cellCount = cols * rows;
+        order.assign(cellCount, 0);
+        leaveAt.assign(cellCount, 0);
+        leaveStamp.assign(cellCount, 0u);
+        leaveGeneration = 0;
+        detour.clear();
+        bombPlanned = 0;
+        aligned = false;
+        bool byRows = rows % 2 == 0;
+        hasCycle = (byRows || cols % 2 == 0) && cols >= 2 && rows >= 2;
+        if (!hasCycle) return;
+
+        // Lay the serpentine out on a (lanes x length) grid, then map it back
+        int lanes = byRows ? rows : cols;
+        int length = byRows ? cols : rows;
+        int place = 0;
+        auto assign = [&](int lane, int along) {
+            int x = byRows ? along : lane;
+            int y = byRows ? lane : along;
+            order[y * cols + x] = place++;
+        };
+        for (int lane = 0; lane < lanes; ++lane) {
+            if (lane % 2 == 0) {
+                for (int along = 1; along < length; ++along) assign(lane, along);
+            }
+            else {
+                for (int along = length - 1; along >= 1; --along) assign(lane, along);
+            }
+        }
+        for (int lane = lanes - 1; lane >= 0; --lane) assign(lane, 0);
+    }
+
+    bool inBounds(const Position& cell) const {
+        return cell.x >= 0 && cell.x < cols && cell.y >= 0 && cell.y < rows;
+    }
+
+    // Whether each segment sits strictly behind the one before it on the cycle
+    bool checkAligned(const SnakeBody& body) const {
+        int behind = 0;
+        for (size_t i = 1; i < body.size(); ++i) {
+            int step = ahead(orderOf(body[i]), orderOf(body[i - 1]));
+            if (step == 0) return false;
+            behind += step;
+            if (behind >= cellCount) return false;
+        }
+        return true;
+    }
+
+    // Whether, arriving on cell after the given number of ticks (the last of
+    // them along trial), the head could follow the cycle from there and find
+    // every segment gone and the bomb out of the way by the time it gets there
+    bool cycleClearFrom(const GameSimulation& sim, const Position& cell, int arrival) const {
+        const SnakeBody& body = sim.getSnake().getBody();
+        int length = static_cast<int>(body.size());
+        int delay = sim.getSnake().isGrowing() ? 1 : 0;
+        int start = orderOf(cell);
+        // The bomb and the walk first, as they are cheap to check
+        if (sim.isBombVisible()) {
+            int reachedAt = arrival + ahead(start, orderOf(sim.getBomb()));
+            if (reachedAt <= static_cast<int>(sim.getBombMovesLeft())) return false;
+        }
+        for (size_t j = 0; j + 1 < trial.size(); ++j) {
+            int reachedAt = arrival + ahead(start, orderOf(trial[j]));
+            if (reachedAt < static_cast<int>(j) + 1 + length + delay) return false;
+        }
+        for (int i = 0; i < length; ++i) {
+            int reachedAt = arrival + ahead(start, orderOf(body[i]));
+            if (reachedAt < length - i + delay) return false;
+        }
+        return true;
+    }
+
+    // Depth-first over walks of up to maxDetour cells that only step where
+    // the body has already left, stopping at the first that rejoins the cycle
+    bool findDetour(const GameSimulation& sim, const Position& from) {
+        int tick = static_cast<int>(trial.size());
+        if (tick > 0 && cycleClearFrom(sim, from, tick)) return true;
+        if (tick == maxDetour) return false;
+        const SnakeBody& body = sim.getSnake().getBody();
+        for (int move = 0; move < 4; ++move) {
+            Position next{ from.x + moveX(move), from.y + moveY(move) };
+            if (!inBounds(next)) continue;
+            if (sim.isBombVisible() && next == sim.getBomb()) continue;
+            if (tick == 0 && body.size() > 1 && next == body[1]) continue;
+            int index = next.y * cols + next.x;
+            if (leaveStamp[index] == leaveGeneration && leaveAt[index] > tick + 1) continue;
+            if (std::find(trial.begin(), trial.end(), next) != trial.end()) continue;
+            trial.push_back(next);
+            if (findDetour(sim, next)) return true;
+            trial.pop_back();
+        }
+        return false;
+    }
+
+    // Searches for such a walk from the head and keeps it in detour
+    bool planDetour(const GameSimulation& sim) {
+        if (++leaveGeneration == 0) {
+            std::fill(leaveStamp.begin(), leaveStamp.end(), 0u);
+            leaveGeneration = 1;
+        }
+        const SnakeBody& body = sim.getSnake().getBody();
+        int length = static_cast<int>(body.size());
+        int delay = sim.getSnake().isGrowing() ? 1 : 0;
+        for (int i = 0; i < length; ++i) {
+            int index = body[i].y * cols + body[i].x;
+            if (leaveStamp[index] != leaveGeneration) {
+                leaveStamp[index] = leaveGeneration;
+                leaveAt[index] = 0;
+            }
+            leaveAt[index] = std::max(leaveAt[index], length - i + delay);
+        }
+        trial.clear();
+        bool found = findDetour(sim, sim.getSnake().getHead());
+        detour.swap(trial);
+        trial.clear();
+        if (!found) detour.clear();
+        detourNext = 0;
+        detourTick = sim.getTicks();
+        return found;
+    }
+
+    // The move onto the next cell of the walk being followed, or -1 once it
+    // is done or something got in its way
+    int detourMove(const GameSimulation& sim) {
+        if (detourNext >= detour.size() || sim.getTicks() != detourTick + detourNext) return -1;
+        const Position& next = detour[detourNext];
+        Position head = sim.getSnake().getHead();
+        for (int move = 0; move < 4; ++move) {
+            if (next == Position{ head.x + moveX(move), head.y + moveY(move) } && !sim.isBlocked(next)) {
+                ++detourNext;
+                return move;
+            }
+        }
+        detour.clear();
+        return -1;
+    }
+
+public:
+    HamiltonianSolver()
+        : cols(0), rows(0), cellCount(0), hasCycle(false), aligned(false), leaveGeneration(0),
+          detourNext(0), detourTick(0), bombPlanned(0) {}
+
+    void begin(const GameSimulation& sim) {
+        build(sim.getCols(), sim.getRows());
+        fallback.prepare(sim.getCols(), sim.getRows());
+    }
+
+    bool isOnCycle() const { return hasCycle && aligned; }
+
+    GameSimulation::Action choose(const GameSimulation& sim) {
+        static const GameSimulation::Action actions[] = {
+            GameSimulation::Action::Up, GameSimulation::Action::Down,
+            GameSimulation::Action::Left, GameSimulation::Action::Right
+        };
+        if (sim.getCols() != cols || sim.getRows() != rows) build(sim.getCols(), sim.getRows());
+        // Walls of a loaded level break the cycle; leave those to the search
+        if (!hasCycle || sim.hasObstacles()) return fallback.choose(sim);
+
+        const Snake& snake = sim.getSnake();
+        const SnakeBody& body = snake.getBody();
+        Position head = snake.getHead();
+        int planned = detourMove(sim);
+        if (planned >= 0) {
+            aligned = false;
+            return actions[planned];
+        }
+        if (!aligned) aligned = checkAligned(body);
+
+        int headOrder = orderOf(head);
+        int toTail = ahead(headOrder, orderOf(body.back()));
+        int toApple = ahead(headOrder, orderOf(sim.getApple()));
+        int margin = 3 + (snake.isGrowing() ? 1 : 0);
+        bool shortcuts = static_cast<int>(body.size()) * 2 < cellCount;
+        int toBomb = aligned && sim.isBombVisible() ? ahead(headOrder, orderOf(sim.getBomb())) : 0;
+        // Only a bomb before the tail and still there when the head arrives is in the way
+        if (toBomb >= toTail || toBomb > static_cast<int>(sim.getBombMovesLeft())) toBomb = 0;
+
+        int bestMove = -1;
+        int bestStep = 0;
+        for (int move = 0; move < 4; ++move) {
+            Position next{ head.x + moveX(move), head.y + moveY(move) };
+            if (!inBounds(next)) continue;
+            if (sim.isBombVisible() && next == sim.getBomb()) continue;
+            int step = ahead(headOrder, orderOf(next));
+            if (step == 0) continue;
+            if (aligned) {
+                // Next on the cycle is always free; anything further must not
+                // pass the tail or the apple
+                bool valid = step == 1 || (shortcuts && step < toTail - margin && step <= toApple) ||
+                    (toBomb > 0 && step > toBomb && step < toTail - margin);
+                if (!valid) continue;
+            }
+            else {
+                if (body.size() > 1 && next == body[1]) continue;
+                if (!cycleClearFrom(sim, next, 1)) continue;
+            }
+            if (bestMove < 0 || (aligned ? step > bestStep : step < bestStep)) {
+                bestMove = move;
+                bestStep = step;
+            }
+        }
+        bool bombInWay = toBomb > 0 && bestStep <= toBomb;
+        if (bestMove >= 0 && !bombInWay) return actions[bestMove];
+        // Plan the way around a bomb no jump clears once, as soon as it shows
+        // up, while the cells around it may still be free
+        unsigned long long bombGone = sim.getTicks() + sim.getBombMovesLeft();
+        if (sim.isBombVisible() && bombGone != bombPlanned) {
+            bombPlanned = bombGone;
+            if (planDetour(sim)) {
+                aligned = false;
+                return actions[detourMove(sim)];
+            }
+        }
+        if (bestMove >= 0) return actions[bestMove];
+
+        // A bomb with no way past it, or the body nowhere near cycle order
+        aligned = false;
+        GameSimulation::Action action = fallback.choose(sim);
+        Position direction = snake.getDirection();
+        for (int move = 0; move < 4; ++move) {
+            if (actions[move] == action) direction = Position{ moveX(move), moveY(move) };
+        }
+        if (!sim.isBlocked(Position{ head.x + direction.x, head.y + direction.y })) return action;
+        for (int move = 0; move < 4; ++move) {
+            Position next{ head.x + moveX(move), head.y + moveY(move) };
+            if (!sim.isBlocked(next) && !(body.size() > 1 && next == body[1])) return actions[move];
+        }
+        return action;
+    }
+};
+
+#endif // HAMILTONIANSOLVER_H
\ No newline at end of file
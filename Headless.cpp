@@ -0,0 +1,262 @@
+#include "GameSimulation.h"
+#include "GameRandom.h"
+#include "BotPolicy.h"
+#include "BatchRunner.h"
+#include "Replay.h"
+#include "FrameProfiler.h"
+#include "LevelFile.h"
+#include "SnakeArena.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+// Fast-forwards a replay with no rendering and checks it ends the way the
+// recording says it did
+int verifyReplay(const char* path) {
+    ReplayReader replay;
+    if (!replay.open(path)) {
+        std::printf("Could not read replay %s\n", path);
+        return 1;
+    }
+    GameSimulation sim;
+    auto start = std::chrono::steady_clock::now();
+    replay.start(sim);
+    while (true) {
+        replay.apply(sim);
+        if (replay.isFinished(sim)) break;
+        sim.step();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::printf("Replayed %llu ticks in %.3f s: score %d, apples %d, seed %llu\n",
+        sim.getTicks(), seconds, sim.getScore(), sim.getAppleCount(),
+        static_cast<unsigned long long>(replay.getSeed()));
+    if (!replay.hasSummary()) {
+        std::printf("Replay has no summary (recording was cut off), nothing to verify\n");
+        return 0;
+    }
+    if (!replay.matches(sim)) {
+        std::printf("MISMATCH: recording ended at tick %llu with score %d, apples %d\n",
+            replay.getEndTick(), replay.getFinalScore(), replay.getFinalApples());
+        return 2;
+    }
+    std::printf("Replay verified\n");
+    return 0;
+}
+
+// Plays gameCount independent games across threadCount workers and prints
+// the aggregated outcome, score, length and survival histograms. A loaded
+// level, if given, is played instead of level.
+int runBatch(GameSimulation::Level level, const LevelDefinition* loadedLevel, int boardCols, int boardRows, std::uint64_t seed,
+    unsigned long long gameCount, unsigned long long maxTicksPerGame, const std::string& policyName, unsigned threadCount) {
+    BatchRunner runner(level, seed, maxTicksPerGame, policyName, threadCount);
+    runner.setBoardSize(boardCols, boardRows);
+    runner.setLoadedLevel(loadedLevel);
+    auto start = std::chrono::steady_clock::now();
+    BatchStats stats = runner.run(gameCount);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::printf("%llu games (%llu ticks) with the %s bot on %u threads in %.3f s (%.0f games/s, %.0f ticks/s), seeds %llu..%llu\n",
+        stats.games, stats.ticks, policyName.c_str(), runner.getThreadCount(), seconds,
+        seconds > 0 ? stats.games / seconds : 0.0, seconds > 0 ? stats.ticks / seconds : 0.0,
+        static_cast<unsigned long long>(seed), static_cast<unsigned long long>(seed + gameCount - 1));
+    stats.print(stdout);
+    return 0;
+}
+
+// Steps an arena of bots on one thread and reports the tick rate, the
+// slowest tick against the 60 ticks/s budget, and a checksum of the final
+// state so two runs of the same seed can be compared
+int runArena(const ArenaSettings& settings, std::uint64_t seed, unsigned long long tickCount) {
+    SnakeArena arena;
+    auto setupStart = std::chrono::steady_clock::now();
+    arena.reset(settings, seed);
+    double setupSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - setupStart).count();
+
+    double slowest = 0;
+    auto start = std::chrono::steady_clock::now();
+    auto tickStart = start;
+    for (unsigned long long tick = 0; tick < tickCount; ++tick) {
+        arena.step();
+        auto tickEnd = std::chrono::steady_clock::now();
+        slowest = std::max(slowest, std::chrono::duration<double>(tickEnd - tickStart).count());
+        tickStart = tickEnd;
+    }
+    double seconds = std::chrono::duration<double>(tickStart - start).count();
+
+    std::printf("Arena of %d snakes on %dx%d (set up in %.1f ms): %llu ticks in %.3f s (%.0f ticks/s), "
+        "mean %.3f ms/tick, slowest %.3f ms, seed %llu\n",
+        arena.getSnakeCount(), arena.getCols(), arena.getRows(), setupSeconds * 1e3, tickCount, seconds,
+        seconds > 0 ? tickCount / seconds : 0.0, tickCount > 0 ? seconds * 1e3 / tickCount : 0.0, slowest * 1e3,
+        static_cast<unsigned long long>(seed));
+    std::printf("Alive %d, apples %d, deaths: %llu hit wall, %llu hit snake, %llu head-on\n",
+        arena.getAliveCount(), arena.getAppleCount(), arena.getDeaths(SnakeArena::Death::HitWall),
+        arena.getDeaths(SnakeArena::Death::HitSnake), arena.getDeaths(SnakeArena::Death::HeadOn));
+    std::printf("Checksum %016llx\n", static_cast<unsigned long long>(arena.checksum()));
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    GameSimulation::Level level = GameSimulation::Level::Level1;
+    unsigned long long tickBudget = 10000000ULL;
+    std::uint64_t seed = 12345;
+    int boardCols = GameSimulation::startCols;
+    int boardRows = GameSimulation::startRows;
+    const char* recordPath = nullptr;
+    const char* levelPath = nullptr;
+    std::string policyName = "random";
+    unsigned long long batchGames = 0;
+    unsigned long long maxTicksPerGame = 100000ULL;
+    unsigned threadCount = std::thread::hardware_concurrency();
+    bool profile = false;
+    int arenaSnakes = 0;
+    bool boardGiven = false;
+    bool ticksGiven = false;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--level") == 0 && i + 1 < argc) {
+            int number = std::atoi(argv[++i]);
+            level = number == 3 ? GameSimulation::Level::Level3 :
+                number == 2 ? GameSimulation::Level::Level2 : GameSimulation::Level::Level1;
+        }
+        else if (std::strcmp(argv[i], "--level-file") == 0 && i + 1 < argc) {
+            levelPath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--ticks") == 0 && i + 1 < argc) {
+            tickBudget = std::strtoull(argv[++i], nullptr, 10);
+            ticksGiven = true;
+        }
+        else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (std::strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            recordPath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            return verifyReplay(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--policy") == 0 && i + 1 < argc) {
+            policyName = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--games") == 0 && i + 1 < argc) {
+            batchGames = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threadCount = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if (std::strcmp(argv[i], "--max-ticks") == 0 && i + 1 < argc) {
+            maxTicksPerGame = std::strtoull(argv[++i], nullptr, 10);
+        }
+        // A size that does not parse falls through to the usage text
+        else if (std::strcmp(argv[i], "--board") == 0 && i + 1 < argc &&
+            std::sscanf(argv[i + 1], "%dx%d", &boardCols, &boardRows) == 2) {
+            ++i;
+            boardGiven = true;
+        }
+        else if (std::strcmp(argv[i], "--arena") == 0 && i + 1 < argc) {
+            arenaSnakes = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--profile") == 0) {
+            profile = true;
+        }
+        else {
+            std::printf("Usage: %s [--level 1|2|3 | --level-file FILE] [--board WxH] [--seed N] [--policy NAME] [--ticks N] [--record FILE] [--profile]\n"
+                "       %s --games N [--threads N] [--max-ticks N] [--level 1|2|3 | --level-file FILE] [--board WxH] [--seed N] [--policy NAME]\n"
+                "       %s --arena SNAKES [--board WxH] [--ticks N] [--seed N]\n"
+                "       %s --replay FILE\n"
+                "Policies: %s\n", argv[0], argv[0], argv[0], argv[0], policyNames());
+            return 1;
+        }
+    }
+
+    // Bots only, one apple per snake; 2000x2000 and 10 s of play unless given
+    if (arenaSnakes > 0) {
+        ArenaSettings settings;
+        settings.cols = boardGiven ? boardCols : static_cast<int>(SnakeArena::maxBoardSide);
+        settings.rows = boardGiven ? boardRows : static_cast<int>(SnakeArena::maxBoardSide);
+        settings.snakes = arenaSnakes;
+        settings.players = 0;
+        settings.apples = arenaSnakes;
+        return runArena(settings, seed, ticksGiven ? tickBudget : 600);
+    }
+
+    std::unique_ptr<BotPolicy> policy = createPolicy(policyName);
+    if (!policy) {
+        std::printf("Unknown policy %s (choose from %s)\n", policyName.c_str(), policyNames());
+        return 1;
+    }
+
+    // A level file replaces --level and --board
+    LevelDefinition loadedLevel;
+    if (levelPath) {
+        std::string error;
+        auto loadStart = std::chrono::steady_clock::now();
+        if (!LevelFile::load(levelPath, loadedLevel, error)) {
+            std::printf("Could not load level: %s\n", error.c_str());
+            return 1;
+        }
+        double loadMicroseconds = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - loadStart).count();
+        std::printf("Loaded %s (%dx%d, %d walls) in %.0f us\n", loadedLevel.name.c_str(), loadedLevel.cols, loadedLevel.rows,
+            loadedLevel.obstacles.getCount(), loadMicroseconds);
+        if (recordPath) {
+            std::printf("Replays only cover the built-in levels; --record ignored\n");
+            recordPath = nullptr;
+        }
+    }
+
+    if (batchGames > 0) {
+        return runBatch(level, levelPath ? &loadedLevel : nullptr, boardCols, boardRows, seed, batchGames,
+            maxTicksPerGame, policyName, threadCount);
+    }
+
+    GameSimulation sim;
+    sim.setBoardSize(boardCols, boardRows);
+    // The bot gets its own stream, so the same --seed gives the same run
+    GameRandom rng(seed, 0);
+    unsigned long long totalTicks = 0;
+    unsigned long long games = 0;
+    long long totalScore = 0;
+    // Recording plays a single game so the file holds exactly one replay
+    ReplayWriter recorder;
+    // With --profile each tick is a profiler frame: the bot's choice is its
+    // input and the step its simulation
+    FrameProfiler profiler(1 << 16);
+
+    auto start = std::chrono::steady_clock::now();
+    while (totalTicks < tickBudget) {
+        if (levelPath) sim.reset(loadedLevel, seed + games);
+        else sim.reset(level, seed + games);
+        policy->begin(sim);
+        if (recordPath && !recorder.begin(recordPath, sim)) {
+            std::printf("Could not write replay %s\n", recordPath);
+            return 1;
+        }
+        while (!sim.isOver() && totalTicks < tickBudget) {
+            if (profile) PROFILE_BEGIN_FRAME(profiler);
+            GameSimulation::Action action = policy->choose(sim, rng);
+            if (profile) PROFILE_MARK(profiler, FrameProfiler::Input);
+            recorder.steer(sim, action);
+            sim.step(action);
+            if (profile) {
+                PROFILE_MARK(profiler, FrameProfiler::Simulation);
+                PROFILE_END_FRAME(profiler, 0, 0);
+            }
+            ++totalTicks;
+        }
+        ++games;
+        totalScore += sim.getScore();
+        if (recordPath) {
+            recorder.finish(sim);
+            break;
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::printf("%llu ticks across %llu games in %.3f s (%.0f ticks/s), average score %.2f, seed %llu\n",
+        totalTicks, games, seconds, seconds > 0 ? totalTicks / seconds : 0.0,
+        games > 0 ? static_cast<double>(totalScore) / games : 0.0, static_cast<unsigned long long>(seed));
+    if (profile) std::fputs(profiler.report("tick").c_str(), stdout);
+    return 0;
+}
@@ -0,0 +1,109 @@
+#ifndef HELPSCREEN_H
+#define HELPSCREEN_H
+
+#include <SFML/Graphics.hpp>
+
+// The help page, drawn in the main window like the other menus. It keeps
+// the old 800x600 layout, centred in the window. The background gradient,
+// the text box and the Back button are baked into one vertex array when
+// the screen is built, and the texts are set up once, so showing help is a
+// state change and each frame is four draws. Until the font arrives from
+// the asset loader only the background is shown.
+class HelpScreen {
+private:
+    sf::VertexArray shapes;
+    sf::Text titleText;
+    sf::Text helpText;
+    sf::Text backText;
+    sf::FloatRect backBounds;
+    sf::Vector2f offset; // Top left of the 800x600 layout
+    bool fontLoaded;
+
+    void addQuad(const sf::FloatRect& rect, const sf::Color& color) {
+        shapes.append(sf::Vertex(sf::Vector2f(rect.left, rect.top), color));
+        shapes.append(sf::Vertex(sf::Vector2f(rect.left + rect.width, rect.top), color));
+        shapes.append(sf::Vertex(sf::Vector2f(rect.left + rect.width, rect.top + rect.height), color));
+        shapes.append(sf::Vertex(sf::Vector2f(rect.left, rect.top + rect.height), color));
+    }
+
+    // Same look as a RectangleShape with an outline drawn outside it
+    void addBox(const sf::FloatRect& rect, const sf::Color& fill, const sf::Color& outline, float thickness) {
+        addQuad(rect, fill);
+        addQuad(sf::FloatRect(rect.left - thickness, rect.top - thickness, rect.width + 2 * thickness, thickness), outline);
+        addQuad(sf::FloatRect(rect.left - thickness, rect.top + rect.height, rect.width + 2 * thickness, thickness), outline);
+        addQuad(sf::FloatRect(rect.left - thickness, rect.top, thickness, rect.height), outline);
+        addQuad(sf::FloatRect(rect.left + rect.width, rect.top, thickness, rect.height), outline);
+    }
+
+public:
+    HelpScreen(float width, float height)
+        : shapes(sf::Quads), offset((width - 800) / 2, (height - 600) / 2), fontLoaded(false) {
+        shapes.append(sf::Vertex(sf::Vector2f(0, 0), sf::Color(60, 60, 60)));
+        shapes.append(sf::Vertex(sf::Vector2f(width, 0), sf::Color(80, 80, 80)));
+        shapes.append(sf::Vertex(sf::Vector2f(width, height), sf::Color(80, 80, 80)));
+        shapes.append(sf::Vertex(sf::Vector2f(0, height), sf::Color(60, 60, 60)));
+    }
+
+    void setFont(const sf::Font& font) {
+        if (fontLoaded) return;
+        fontLoaded = true;
+
+        addBox(sf::FloatRect(offset.x + 50, offset.y + 80, 700, 400),
+            sf::Color(240, 240, 240, 200), sf::Color(100, 100, 100), 2);
+        backBounds = sf::FloatRect(offset.x + 350, offset.y + 500, 100, 40);
+        addBox(backBounds, sf::Color(100, 100, 100), sf::Color(150, 150, 150), 2);
+
+        titleText.setFont(font);
+        titleText.setCharacterSize(40);
+        titleText.setFillColor(sf::Color(255, 215, 0));
+        titleText.setStyle(sf::Text::Bold);
+        titleText.setString("Help - Snake Game");
+        titleText.setPosition(offset.x + (800 - titleText.getLocalBounds().width) / 2, offset.y + 20);
+
+        helpText.setFont(font);
+        helpText.setCharacterSize(16);
+        helpText.setFillColor(sf::Color::White);
+        helpText.setString("Snake Game - Use arrow keys to move\n"
+                          "Eat apples to grow and increase your score\n"
+                          "Avoid hitting walls, yourself, or bombs!\n"
+                          "Walls shrink every 5 seconds in Level 3!\n\n"
+                          "Scoring:\n"
+                          "- Level 1: Red Apple +1, Big Blue Apple +2\n"
+                          "- Level 2: Red Apple +2, Big Blue Apple +4\n"
+                          "- Level 3: Red Apple +3, Big Blue Apple +6\n\n"
+                          "Controls:\n"
+                          "  Arrow Keys: Move\n"
+                          "  A: Autopilot\n"
+                          "  P: Pause\n"
+                          "  R: Restart\n"
+                          "  ESC: Menu");
+        helpText.setPosition(offset.x + 70, offset.y + 100);
+
+        backText.setFont(font);
+        backText.setCharacterSize(24);
+        backText.setFillColor(sf::Color::White);
+        backText.setStyle(sf::Text::Bold);
+        backText.setString("Back");
+        backText.setPosition(backBounds.left + (backBounds.width - backText.getLocalBounds().width) / 2, backBounds.top + 5);
+    }
+
+    // True when the click was on Back
+    bool handleMouseClick(float x, float y) const {
+        return fontLoaded && backBounds.contains(x, y);
+    }
+
+    void handleMouseMove(float x, float y) {
+        backText.setFillColor(handleMouseClick(x, y) ? sf::Color::Yellow : sf::Color::White);
+    }
+
+    void draw(sf::RenderWindow& window) {
+        window.draw(shapes);
+        if (fontLoaded) {
+            window.draw(titleText);
+            window.draw(helpText);
+            window.draw(backText);
+        }
+    }
+};
+
+#endif // HELPSCREEN_H
\ No newline at end of file
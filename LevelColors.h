@@ -0,0 +1,34 @@
+#ifndef LEVELCOLORS_H
+#define LEVELCOLORS_H
+
+#include <SFML/Graphics.hpp>
+#include "LevelTraits.h"
+
+// A level's palette as SFML colours, made once when the level starts so
+// the renderers are handed ready colours every frame
+struct LevelColors {
+    sf::Color background;
+    sf::Color menuBackground;
+    sf::Color cell1;
+    sf::Color cell2;
+    sf::Color head;
+    sf::Color body;
+    sf::Color apple;
+    sf::Color blueApple;
+    sf::Color bomb;
+    sf::Color obstacle;
+
+    static sf::Color toColor(const Rgb& rgb) {
+        return sf::Color(rgb.r, rgb.g, rgb.b);
+    }
+
+    LevelColors() {}
+
+    explicit LevelColors(const LevelPalette& palette)
+        : background(toColor(palette.background)), menuBackground(toColor(palette.menuBackground)),
+          cell1(toColor(palette.cell1)), cell2(toColor(palette.cell2)), head(toColor(palette.head)),
+          body(toColor(palette.body)), apple(toColor(palette.apple)), blueApple(toColor(palette.blueApple)),
+          bomb(toColor(palette.bomb)), obstacle(toColor(palette.obstacle)) {}
+};
+
+#endif // LEVELCOLORS_H
\ No newline at end of file
@@ -0,0 +1,61 @@
+#ifndef LEVELDEFINITION_H
+#define LEVELDEFINITION_H
+
+#include "LevelTraits.h"
+#include "ObstacleMap.h"
+#include <string>
+
+// Everything a level is made of, as plain run-time data: what a level file
+// (see LevelFile.h) loads into, and what builtIn() makes from LevelTraits.
+// ScoringSystem copies the rules out of it when a game starts; the walls go
+// to the snake's occupancy grid.
+struct LevelDefinition {
+    int baseLevel;  // 1 to 3: the built-in level this one starts from and is shown as
+    std::string name;
+    int cols;       // Board size; built-in levels use the game's board size instead
+    int rows;
+    float moveInterval;
+    int smallAppleScore;
+    int bigAppleScore;
+    bool hasBombs;
+    bool hasShrinkingWalls;
+    float blueAppleInterval; // Timers in seconds
+    float blueAppleVisibleDuration;
+    float bombInterval;
+    float bombVisibleDuration;
+    float wallShrinkInterval;
+    LevelPalette palette;
+    ObstacleMap obstacles;
+
+    template <int N>
+    static LevelDefinition builtIn() {
+        typedef LevelTraits<N> Traits;
+        LevelDefinition level;
+        level.baseLevel = N;
+        level.name = "Level " + std::to_string(N);
+        level.cols = 23;
+        level.rows = 18;
+        level.moveInterval = Traits::moveInterval;
+        level.smallAppleScore = Traits::smallAppleScore;
+        level.bigAppleScore = Traits::bigAppleScore;
+        level.hasBombs = Traits::hasBombs;
+        level.hasShrinkingWalls = Traits::hasShrinkingWalls;
+        level.blueAppleInterval = Traits::blueAppleInterval;
+        level.blueAppleVisibleDuration = Traits::blueAppleVisibleDuration;
+        level.bombInterval = Traits::bombInterval;
+        level.bombVisibleDuration = Traits::bombVisibleDuration;
+        level.wallShrinkInterval = Traits::wallShrinkInterval;
+        level.palette = Traits::palette();
+        return level;
+    }
+
+    static LevelDefinition builtIn(int number) {
+        switch (number) {
+        case 2: return builtIn<2>();
+        case 3: return builtIn<3>();
+        default: return builtIn<1>();
+        }
+    }
+};
+
+#endif // LEVELDEFINITION_H
\ No newline at end of file
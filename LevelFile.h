@@ -0,0 +1,238 @@
+#ifndef LEVELFILE_H
+#define LEVELFILE_H
+
+#include "LevelDefinition.h"
+#include "GameSimulation.h"
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+// Levels as small text files, so new ones ship without a rebuild. One
+// setting per line; anything left out keeps the value of the base level:
+//
+//   snake-level 1
+//   base 2
+//   name Walled Garden
+//   board 30 20
+//   speed 0.12
+//   scores 2 4
+//   blue-apple 10 3
+//   bombs 8 3
+//   shrink off
+//   color obstacle 90 60 30
+//   map
+//   ..............................
+//   ..####........................
+//
+// The first line names the format version. base picks the built-in level
+// (1 to 3) to start from, which is also the level the game shows, and must
+// come before the other settings. board is columns and rows, from 23x18 up
+// to 1000x1000; speed is seconds per move; scores are the red and the blue
+// apple; blue-apple and bombs give how often one appears and how long it
+// stays, in seconds; shrink is how often the walls close in. bombs and
+// shrink also take "off". color sets a palette entry: background,
+// menu-background, cell1, cell2, head, body, apple, blue-apple, bomb or
+// obstacle. map comes last, one line per row, '#' for a wall and '.' for an
+// open cell; without it the board is open. The snake's starting cells,
+// (3, 9) to (6, 9), must be open. Lines starting with ';' are comments,
+// and one may also follow a setting's values; anything else after them is
+// an error.
+//
+// Loading reads the file in one go and the map goes straight into the
+// level's ObstacleMap, so a classic-sized level loads in microseconds and
+// even a 1000x1000 one in a few milliseconds.
+class LevelFile {
+private:
+    static bool fail(std::string& error, int line, const std::string& message) {
+        error = "line " + std::to_string(line) + ": " + message;
+        return false;
+    }
+
+    // Whether nothing but blanks or a comment is left on the line
+    static bool atLineEnd(std::istringstream& in) {
+        in >> std::ws;
+        return in.eof() || in.peek() == ';';
+    }
+
+    static bool readColor(std::istringstream& in, Rgb& color) {
+        int r, g, b;
+        if (!(in >> r >> g >> b) || r < 0 || r > 255 || g < 0 || g > 255 || b < 0 || b > 255) return false;
+        color = Rgb{ static_cast<unsigned char>(r), static_cast<unsigned char>(g), static_cast<unsigned char>(b) };
+        return true;
+    }
+
+    // Entry of the palette called name, or null
+    static Rgb* paletteEntry(LevelPalette& palette, const std::string& name) {
+        if (name == "background") return &palette.background;
+        if (name == "menu-background") return &palette.menuBackground;
+        if (name == "cell1") return &palette.cell1;
+        if (name == "cell2") return &palette.cell2;
+        if (name == "head") return &palette.head;
+        if (name == "body") return &palette.body;
+        if (name == "apple") return &palette.apple;
+        if (name == "blue-apple") return &palette.blueApple;
+        if (name == "bomb") return &palette.bomb;
+        if (name == "obstacle") return &palette.obstacle;
+        return nullptr;
+    }
+
+    // "N M" seconds, both positive, or "off" if allowed
+    static bool readTimer(std::istringstream& in, float& first, float* second, bool& enabled) {
+        std::string word;
+        if (!(in >> word)) return false;
+        if (word == "off") {
+            enabled = false;
+            return true;
+        }
+        first = static_cast<float>(std::atof(word.c_str()));
+        if (first <= 0) return false;
+        if (second && (!(in >> *second) || *second <= 0)) return false;
+        enabled = true;
+        return true;
+    }
+
+    static bool parseMap(const std::string& text, size_t& at, int& line, LevelDefinition& level, std::string& error) {
+        level.obstacles = ObstacleMap(level.cols, level.rows);
+        for (int y = 0; y < level.rows; ++y) {
+            ++line;
+            if (at >= text.size()) return fail(error, line, "map has " + std::to_string(y) + " rows, expected " + std::to_string(level.rows));
+            size_t end = text.find('\n', at);
+            if (end == std::string::npos) end = text.size();
+            size_t width = end - at;
+            if (width > 0 && text[end - 1] == '\r') --width;
+            if (width != static_cast<size_t>(level.cols)) {
+                return fail(error, line, "map row is " + std::to_string(width) + " cells wide, expected " + std::to_string(level.cols));
+            }
+            const char* row = text.data() + at;
+            for (int x = 0; x < level.cols; ++x) {
+                if (row[x] == '#') level.obstacles.set(Position{ x, y });
+                else if (row[x] != '.') return fail(error, line, std::string("unknown map cell '") + row[x] + "'");
+            }
+            at = end + 1;
+        }
+        return true;
+    }
+
+public:
+    static const int formatVersion = 1;
+
+    // Fills level from the text of a level file. On failure level is left
+    // half-filled and error says what and where.
+    static bool parse(const std::string& text, LevelDefinition& level, std::string& error) {
+        level = LevelDefinition::builtIn(1);
+        bool headerSeen = false;
+        bool settingsSeen = false;
+        bool mapSeen = false;
+        int line = 0;
+        int mapLine = 0; // Line of the map keyword; its rows follow
+        const int startRow = 9;
+        size_t at = 0;
+        while (at < text.size() && !mapSeen) {
+            ++line;
+            size_t end = text.find('\n', at);
+            if (end == std::string::npos) end = text.size();
+            std::istringstream in(text.substr(at, end - at));
+            at = end + 1;
+            std::string key;
+            if (!(in >> key) || key[0] == ';') continue;
+
+            if (!headerSeen) {
+                int version = 0;
+                if (key != "snake-level" || !(in >> version)) return fail(error, line, "not a level file");
+                if (version != formatVersion) return fail(error, line, "unsupported version " + std::to_string(version));
+                if (!atLineEnd(in)) return fail(error, line, "unexpected text after the version");
+                headerSeen = true;
+                continue;
+            }
+
+            bool valid = true;
+            if (key == "base") {
+                int base = 0;
+                if (settingsSeen) return fail(error, line, "base must come before the other settings");
+                valid = (in >> base) && base >= 1 && base <= 3;
+                if (valid) level = LevelDefinition::builtIn(base);
+            }
+            else if (key == "name") {
+                std::getline(in >> std::ws, level.name);
+                if (!level.name.empty() && level.name.back() == '\r') level.name.pop_back();
+            }
+            else if (key == "board") {
+                valid = (in >> level.cols >> level.rows) &&
+                    level.cols >= GameSimulation::startCols && level.cols <= GameSimulation::maxBoardSide &&
+                    level.rows >= GameSimulation::startRows && level.rows <= GameSimulation::maxBoardSide;
+            }
+            else if (key == "speed") {
+                valid = (in >> level.moveInterval) && level.moveInterval > 0;
+            }
+            else if (key == "scores") {
+                valid = static_cast<bool>(in >> level.smallAppleScore >> level.bigAppleScore);
+            }
+            else if (key == "blue-apple") {
+                bool enabled = true;
+                valid = readTimer(in, level.blueAppleInterval, &level.blueAppleVisibleDuration, enabled) && enabled;
+            }
+            else if (key == "bombs") {
+                valid = readTimer(in, level.bombInterval, &level.bombVisibleDuration, level.hasBombs);
+            }
+            else if (key == "shrink") {
+                valid = readTimer(in, level.wallShrinkInterval, nullptr, level.hasShrinkingWalls);
+            }
+            else if (key == "color") {
+                std::string entry;
+                Rgb* color = (in >> entry) ? paletteEntry(level.palette, entry) : nullptr;
+                valid = color && readColor(in, *color);
+            }
+            else if (key == "map") {
+                if (!atLineEnd(in)) return fail(error, line, "unexpected text after 'map'");
+                mapLine = line;
+                if (!parseMap(text, at, line, level, error)) return false;
+                mapSeen = true;
+            }
+            else {
+                return fail(error, line, "unknown setting '" + key + "'");
+            }
+            if (!valid) return fail(error, line, "bad value for '" + key + "'");
+            if (!atLineEnd(in)) return fail(error, line, "unexpected text after '" + key + "'");
+            settingsSeen = true;
+        }
+        if (!headerSeen) return fail(error, line, "not a level file");
+
+        if (!mapSeen) level.obstacles = ObstacleMap();
+        for (int x = 3; x <= 6; ++x) {
+            if (level.obstacles.test(Position{ x, startRow })) {
+                return fail(error, mapLine + 1 + startRow,
+                    "wall at (" + std::to_string(x) + ", " + std::to_string(startRow) + ") on the snake's starting row");
+            }
+        }
+        return true;
+    }
+
+    static bool load(const std::string& path, LevelDefinition& level, std::string& error) {
+        std::ifstream in(path.c_str(), std::ios::binary);
+        if (!in) {
+            error = "cannot open " + path;
+            return false;
+        }
+        std::string text;
+        in.seekg(0, std::ios::end);
+        std::streamoff size = in.tellg();
+        if (size < 0) {
+            error = "cannot read " + path;
+            return false;
+        }
+        text.resize(static_cast<size_t>(size));
+        in.seekg(0, std::ios::beg);
+        if (!text.empty() && !in.read(&text[0], static_cast<std::streamsize>(text.size()))) {
+            error = "cannot read " + path;
+            return false;
+        }
+        if (!parse(text, level, error)) {
+            error = path + ", " + error;
+            return false;
+        }
+        return true;
+    }
+};
+
+#endif // LEVELFILE_H
\ No newline at end of file
@@ -0,0 +1,95 @@
+#ifndef LEVELTRAITS_H
+#define LEVELTRAITS_H
+
+// Everything that differs between the levels, fixed at compile time. Code
+// that runs every tick or for every segment is written once as a template
+// over the level number and instantiated for each level, and the level is
+// picked once when a game starts (see GameSimulation::reset), so inside a
+// tick there is no "which level is this" test left. No SFML here; the
+// colours are turned into sf::Color by LevelColors. Levels loaded from a
+// file (see LevelFile.h) start from one of these and override any field.
+
+struct Rgb {
+    unsigned char r, g, b;
+};
+
+struct LevelPalette {
+    Rgb background;
+    Rgb menuBackground; // Behind the menus after playing this level
+    Rgb cell1;
+    Rgb cell2;
+    Rgb head;
+    Rgb body;
+    Rgb apple;
+    Rgb blueApple;
+    Rgb bomb;
+    Rgb obstacle; // Walls of levels loaded from a file
+};
+
+// Pickup and wall shrink timers in seconds, the same for every built-in level
+struct LevelTimers {
+    static constexpr float blueAppleInterval = 10.0f;
+    static constexpr float blueAppleVisibleDuration = 3.0f;
+    static constexpr float bombInterval = 8.0f;
+    static constexpr float bombVisibleDuration = 3.0f;
+    static constexpr float wallShrinkInterval = 5.0f;
+};
+
+template <int N>
+struct LevelTraits;
+
+template <>
+struct LevelTraits<1> : LevelTimers {
+    static constexpr float moveInterval = 0.15f;
+    static constexpr int smallAppleScore = 1;
+    static constexpr int bigAppleScore = 2;
+    static constexpr bool hasBombs = false;
+    static constexpr bool hasShrinkingWalls = false;
+    static constexpr LevelPalette palette() {
+        return LevelPalette{
+            { 34, 139, 34 }, { 0, 0, 0 },     // Forest green, black menus
+            { 144, 238, 144 }, { 152, 251, 152 },
+            { 0, 0, 139 }, { 65, 105, 225 },  // Dark blue head, royal blue body
+            { 255, 0, 0 }, { 0, 0, 255 }, { 0, 0, 0 },
+            { 101, 67, 33 }                   // Brown walls
+        };
+    }
+};
+
+template <>
+struct LevelTraits<2> : LevelTimers {
+    static constexpr float moveInterval = 0.1f; // Faster snake speed
+    static constexpr int smallAppleScore = 2;
+    static constexpr int bigAppleScore = 4;
+    static constexpr bool hasBombs = true;
+    static constexpr bool hasShrinkingWalls = false;
+    static constexpr LevelPalette palette() {
+        return LevelPalette{
+            { 50, 50, 100 }, { 50, 50, 100 },      // Dark blue background
+            { 100, 100, 150 }, { 120, 120, 170 },  // Light purple cells
+            { 200, 50, 50 }, { 255, 100, 100 },    // Red head, light red body
+            { 255, 255, 0 }, { 0, 255, 255 }, { 0, 0, 0 }, // Yellow apple, cyan blue apple
+            { 25, 25, 60 }                         // Near-black walls
+        };
+    }
+};
+
+template <>
+struct LevelTraits<3> : LevelTimers {
+    static constexpr float moveInterval = 0.1f; // Same speed as Level 2
+    static constexpr int smallAppleScore = 3;
+    static constexpr int bigAppleScore = 6;
+    static constexpr bool hasBombs = true;
+    static constexpr bool hasShrinkingWalls = true;
+    static constexpr LevelPalette palette() {
+        return LevelPalette{
+            { 80, 20, 80 }, { 80, 20, 80 },        // Dark purple background
+            { 150, 50, 150 }, { 170, 70, 170 },    // Magenta cells
+            { 50, 200, 50 }, { 100, 255, 100 },    // Green head, light green body
+            { 255, 165, 0 }, { 255, 105, 180 }, { 0, 0, 0 }, // Orange apple, pink blue apple
+            { 40, 10, 40 }                         // Near-black walls
+        };
+    }
+};
+
+#endif // LEVELTRAITS_H
\ No newline at end of file
@@ -0,0 +1,44 @@
+#ifndef MENULAYOUT_H
+#define MENULAYOUT_H
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include <string>
+
+// Layout shared by the main and level menus: a column of centred items and
+// a background picture stretched over the top of the window
+struct MenuLayout {
+    static const unsigned itemSize = 36;
+    static constexpr float firstItemY = 450.0f;
+    static constexpr float itemSpacing = 70.0f;
+
+    // Centres item i of the column at the given scale
+    static void placeItem(sf::Text& item, size_t i, float scale, float windowWidth) {
+        item.setScale(scale, scale);
+        sf::FloatRect bounds = item.getLocalBounds();
+        item.setPosition((windowWidth - bounds.width * scale) / 2, firstItemY + i * itemSpacing);
+    }
+
+    static void addItems(std::vector<sf::Text>& items, const sf::Font& font,
+        const std::vector<std::string>& names, float windowWidth) {
+        for (size_t i = 0; i < names.size(); ++i) {
+            sf::Text text;
+            text.setFont(font);
+            text.setCharacterSize(itemSize);
+            text.setString(names[i]);
+            text.setFillColor(sf::Color::White);
+            text.setStyle(sf::Text::Bold);
+            placeItem(text, i, 1.0f, windowWidth);
+            items.push_back(text);
+        }
+    }
+
+    // Stretches the picture to windowWidth x height at the top left
+    static void fitBackground(sf::Sprite& sprite, const sf::Texture& texture, float windowWidth, float height) {
+        sprite.setTexture(texture);
+        sprite.setScale(windowWidth / texture.getSize().x, height / texture.getSize().y);
+        sprite.setPosition(0, 0);
+    }
+};
+
+#endif // MENULAYOUT_H
\ No newline at end of file
@@ -0,0 +1,67 @@
+#ifndef OBSTACLEMAP_H
+#define OBSTACLEMAP_H
+
+#include "Position.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Fixed walls inside the board, one bit per cell packed 64 to a word, so a
+// 1000x1000 layout is 125 KB and copying one into a new game is a memcpy.
+// Nothing reads this during a tick: the occupancy grid takes the walls in
+// once when a game starts (OccupancyGrid::setObstacles) and from then on
+// they are just cells that are never free.
+class ObstacleMap {
+private:
+    std::vector<std::uint64_t> words;
+    int width;
+    int height;
+    int count;
+
+    size_t indexOf(const Position& position) const {
+        return static_cast<size_t>(position.y) * width + position.x;
+    }
+
+public:
+    ObstacleMap() : width(0), height(0), count(0) {}
+    ObstacleMap(int width, int height)
+        : words((static_cast<size_t>(width) * height + 63) / 64, 0), width(width), height(height), count(0) {}
+
+    bool inBounds(const Position& position) const {
+        return position.x >= 0 && position.x < width && position.y >= 0 && position.y < height;
+    }
+
+    bool test(const Position& position) const {
+        if (!inBounds(position)) return false;
+        size_t index = indexOf(position);
+        return (words[index / 64] >> (index % 64)) & 1;
+    }
+
+    void set(const Position& position) {
+        if (!inBounds(position) || test(position)) return;
+        size_t index = indexOf(position);
+        words[index / 64] |= std::uint64_t(1) << (index % 64);
+        ++count;
+    }
+
+    // Calls visit(position) for every wall, skipping empty words whole
+    template <typename Visit>
+    void forEach(Visit visit) const {
+        for (size_t word = 0; word < words.size(); ++word) {
+            std::uint64_t bits = words[word];
+            for (size_t bit = 0; bits != 0; ++bit, bits >>= 1) {
+                if (bits & 1) {
+                    size_t index = word * 64 + bit;
+                    visit(Position{ static_cast<int>(index % width), static_cast<int>(index / width) });
+                }
+            }
+        }
+    }
+
+    bool empty() const { return count == 0; }
+    int getCount() const { return count; }
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+};
+
+#endif // OBSTACLEMAP_H
\ No newline at end of file
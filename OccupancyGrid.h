@@ -0,0 +1,156 @@
+#ifndef OCCUPANCYGRID_H
+#define OCCUPANCYGRID_H
+
+#include "Position.h"
+#include "ObstacleMap.h"
+#include <vector>
+#include "GameRandom.h"
+#include <algorithm>
+
+// One counter per board cell, kept up to date as the head enters a cell and
+// the tail leaves one. This is the single answer to "is this cell taken", so
+// collision and spawn checks cost the same no matter how long the snake is.
+// Counts rather than flags because Level 3's wall clamp can stack segments.
+//
+// Alongside the counters the grid keeps a dense list of the free cells inside
+// the playable bounds (plus each cell's slot in that list), so a uniformly
+// random free cell can be drawn in constant time even on a nearly full board.
+//
+// A level's fixed walls live in the same counters, as a high bit that is
+// set once per game: a wall cell is never zero, so it is never listed as
+// free, and the collision check that already looks at the head's counter
+// catches a wall too. countAt() masks the bit off and reports segments only.
+class OccupancyGrid {
+private:
+    static const unsigned short obstacleBit = 0x8000;
+    static const unsigned short countMask = 0x7FFF;
+
+    std::vector<unsigned short> cells;
+    std::vector<int> freeCells;
+    std::vector<int> freeSlot; // Index into freeCells, or -1 when not listed
+    int width;
+    int height;
+    int playCols;
+    int playRows;
+    bool walls;
+
+    int indexOf(const Position& position) const {
+        return position.y * width + position.x;
+    }
+
+    bool inPlayArea(int index) const {
+        return index % width < playCols && index / width < playRows;
+    }
+
+    void listFree(int index) {
+        freeSlot[index] = static_cast<int>(freeCells.size());
+        freeCells.push_back(index);
+    }
+
+    // Swap-with-last removal keeps the list dense
+    void unlistFree(int index) {
+        int slot = freeSlot[index];
+        int last = freeCells.back();
+        freeCells[slot] = last;
+        freeSlot[last] = slot;
+        freeCells.pop_back();
+        freeSlot[index] = -1;
+    }
+
+    void rebuildFreeCells() {
+        freeCells.clear();
+        std::fill(freeSlot.begin(), freeSlot.end(), -1);
+        for (int y = 0; y < playRows; ++y) {
+            for (int x = 0; x < playCols; ++x) {
+                int index = y * width + x;
+                if (cells[index] == 0) listFree(index);
+            }
+        }
+    }
+
+public:
+    OccupancyGrid() : width(0), height(0), playCols(0), playRows(0), walls(false) {}
+    OccupancyGrid(int width, int height)
+        : cells(static_cast<size_t>(width) * height, 0), freeSlot(static_cast<size_t>(width) * height, -1),
+          width(width), height(height), playCols(width), playRows(height), walls(false) {
+        freeCells.reserve(cells.size());
+        rebuildFreeCells();
+    }
+
+    bool inBounds(const Position& position) const {
+        return position.x >= 0 && position.x < width && position.y >= 0 && position.y < height;
+    }
+
+    void add(const Position& position) {
+        if (!inBounds(position)) return;
+        int index = indexOf(position);
+        if (cells[index]++ == 0 && freeSlot[index] >= 0) unlistFree(index);
+    }
+
+    void remove(const Position& position) {
+        if (!inBounds(position)) return;
+        int index = indexOf(position);
+        if ((cells[index] & countMask) > 0 && --cells[index] == 0 && inPlayArea(index)) listFree(index);
+    }
+
+    // Segments in the cell, walls not counted
+    int countAt(const Position& position) const {
+        return inBounds(position) ? cells[indexOf(position)] & countMask : 0;
+    }
+
+    // Taken by a segment or a wall
+    bool isOccupied(const Position& position) const {
+        return inBounds(position) && cells[indexOf(position)] != 0;
+    }
+
+    // More than one thing in the cell: a segment on another or on a wall
+    bool isCrowded(const Position& position) const {
+        return inBounds(position) && cells[indexOf(position)] > 1;
+    }
+
+    bool isObstacle(const Position& position) const {
+        return inBounds(position) && (cells[indexOf(position)] & obstacleBit) != 0;
+    }
+
+    // Marks the walls; call on an empty grid, before any segment is added
+    void setObstacles(const ObstacleMap& obstacles) {
+        obstacles.forEach([this](const Position& position) {
+            if (inBounds(position)) cells[indexOf(position)] |= obstacleBit;
+        });
+        walls = walls || !obstacles.empty();
+        rebuildFreeCells();
+    }
+
+    // Removes every segment; the walls stay
+    void clear() {
+        if (walls) {
+            for (auto& cell : cells) cell &= obstacleBit;
+        }
+        else {
+            std::fill(cells.begin(), cells.end(), 0);
+        }
+        rebuildFreeCells();
+    }
+
+    // Restrict spawning to the top-left cols x rows cells (Level 3 wall shrink)
+    void setBounds(int cols, int rows) {
+        playCols = std::min(cols, width);
+        playRows = std::min(rows, height);
+        rebuildFreeCells();
+    }
+
+    // Uniform pick among the free playable cells; false when the board is full
+    bool pickFreeCell(GameRandom& rng, Position& result) const {
+        if (freeCells.empty()) return false;
+        int index = freeCells[rng.nextBelow(static_cast<std::uint32_t>(freeCells.size()))];
+        result.x = index % width;
+        result.y = index / width;
+        return true;
+    }
+
+    int getFreeCount() const { return static_cast<int>(freeCells.size()); }
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+};
+
+#endif // OCCUPANCYGRID_H
@@ -0,0 +1,14 @@
+#ifndef POSITION_H
+#define POSITION_H
+
+struct Position {
+    int x, y;
+    bool operator==(const Position& other) const {
+        return x == other.x && y == other.y;
+    }
+    bool operator!=(const Position& other) const {
+        return !(*this == other);
+    }
+};
+
+#endif // POSITION_H
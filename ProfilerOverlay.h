@@ -0,0 +1,97 @@
+#ifndef PROFILEROVERLAY_H
+#define PROFILEROVERLAY_H
+
+#include <SFML/Graphics.hpp>
+#include "FrameProfiler.h"
+#include "FrameStats.h"
+#include <algorithm>
+#include <cstdio>
+#include <string>
+
+// The F3 table of FrameProfiler numbers, drawn over the top left of the
+// board. The font is proportional, so each column is its own right-aligned
+// sf::Text. The strings are only rebuilt every refreshFrames frames; in
+// between a frame costs five draws and no text layout.
+class ProfilerOverlay {
+private:
+    static const int columnCount = 4;
+    static const int refreshFrames = 30;
+
+    sf::RectangleShape panel;
+    sf::Text columns[columnCount];
+    float columnRight[columnCount];
+    int framesUntilRefresh;
+    bool fontLoaded;
+
+    static std::string number(double value, bool milliseconds) {
+        char text[32];
+        std::snprintf(text, sizeof(text), milliseconds ? "%.2f" : "%.0f", value);
+        return text;
+    }
+
+    void addRow(std::string* cells, const char* name, const FrameProfiler::Summary& summary, bool milliseconds) {
+        cells[0] += std::string("\n") + name;
+        cells[1] += "\n" + number(summary.p50, milliseconds);
+        cells[2] += "\n" + number(summary.p99, milliseconds);
+        cells[3] += "\n" + number(summary.max, milliseconds);
+    }
+
+public:
+    ProfilerOverlay() : framesUntilRefresh(0), fontLoaded(false) {
+        panel.setPosition(50, 50);
+        panel.setFillColor(sf::Color(0, 0, 0, 170));
+        panel.setOutlineColor(sf::Color(255, 215, 0));
+        panel.setOutlineThickness(1);
+        columnRight[0] = 60;
+        columnRight[1] = 250;
+        columnRight[2] = 320;
+        columnRight[3] = 390;
+    }
+
+    void setFont(const sf::Font& font) {
+        for (int i = 0; i < columnCount; ++i) {
+            columns[i].setFont(font);
+            columns[i].setCharacterSize(16);
+            columns[i].setFillColor(sf::Color::White);
+            columns[i].setLineSpacing(1.1f);
+        }
+        fontLoaded = true;
+        framesUntilRefresh = 0;
+    }
+
+    void update(const FrameProfiler& profiler) {
+        if (!fontLoaded || --framesUntilRefresh > 0) return;
+        framesUntilRefresh = refreshFrames;
+#if SNAKE_PROFILING
+        std::string cells[columnCount] = { "ms", "p50", "p99", "max" };
+        for (int i = 0; i < FrameProfiler::phaseCount; ++i) {
+            FrameProfiler::Phase phase = static_cast<FrameProfiler::Phase>(i);
+            addRow(cells, FrameProfiler::phaseName(phase), profiler.summarize(phase), true);
+        }
+        addRow(cells, "frame", profiler.summarizeFrame(), true);
+        addRow(cells, "draw calls", profiler.summarizeDrawCalls(), false);
+        addRow(cells, "vertices", profiler.summarizeVertices(), false);
+#else
+        (void)profiler;
+        std::string cells[columnCount] = { "Profiling is compiled out", "", "", "" };
+#endif
+        float bottom = 0;
+        for (int i = 0; i < columnCount; ++i) {
+            columns[i].setString(cells[i]);
+            sf::FloatRect bounds = columns[i].getLocalBounds();
+            // The name column is left aligned, the numbers right aligned
+            float x = i == 0 ? columnRight[0] : columnRight[i] - bounds.left - bounds.width;
+            columns[i].setPosition(x, 58);
+            bottom = std::max(bottom, 58 + bounds.top + bounds.height);
+        }
+        panel.setSize(sf::Vector2f(columnRight[columnCount - 1] + 10 - 50, bottom + 8 - 50));
+    }
+
+    void draw(sf::RenderTarget& target, FrameStats& stats) {
+        if (!fontLoaded) return;
+        stats.draw(target, panel);
+        for (int i = 0; i < columnCount; ++i) stats.draw(target, columns[i]);
+    }
+};
+
+#endif // PROFILEROVERLAY_H
\ No newline at end of file
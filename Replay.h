@@ -0,0 +1,287 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include "GameSimulation.h"
+#include <cstdio>
+#include <cstdint>
+#include <cstddef>
+
+// Binary replay of one game. Because GameSimulation is deterministic for a
+// seed, a replay only stores the level, the seed and the steer calls:
+//
+//   "SNKR" version level varint(seed) varint(cols) varint(rows)
+//   varint((ticksSincePreviousEvent << 3) | code)   per steer, code 0-3
+//   varint((ticksSincePreviousEvent << 3) | 4)      end of game
+//   varint(score) varint(appleCount) outcome        summary for verification
+//
+// A key press a few moves after the last one is a single byte. Events are
+// tagged with the tick they happened before, so several presses between two
+// moves replay in order exactly as they were pressed. Both ends stream
+// through a small fixed buffer, so a session of any length costs the same
+// memory. A file cut off before the end marker still plays back up to the
+// last complete event.
+namespace ReplayFormat {
+    static const unsigned char magic[4] = { 'S', 'N', 'K', 'R' };
+    static const unsigned char version = 2; // 1 had no board size: always 23x18
+    static const unsigned endCode = 4;
+    static const size_t bufferSize = 4096;
+}
+
+class ReplayWriter {
+private:
+    std::FILE* file;
+    unsigned char buffer[ReplayFormat::bufferSize];
+    size_t used;
+    unsigned long long lastTick;
+
+    void put(unsigned char byte) {
+        if (used == ReplayFormat::bufferSize) flush();
+        buffer[used++] = byte;
+    }
+
+    void putVarint(std::uint64_t value) {
+        while (value >= 0x80) {
+            put(static_cast<unsigned char>(value | 0x80));
+            value >>= 7;
+        }
+        put(static_cast<unsigned char>(value));
+    }
+
+    void putEvent(unsigned long long tick, unsigned code) {
+        putVarint(((tick - lastTick) << 3) | code);
+        lastTick = tick;
+    }
+
+    void flush() {
+        if (file && used > 0) std::fwrite(buffer, 1, used, file);
+        used = 0;
+    }
+
+public:
+    ReplayWriter() : file(nullptr), used(0), lastTick(0) {}
+    ~ReplayWriter() { close(); }
+
+    bool isOpen() const { return file != nullptr; }
+
+    // Call right after sim.reset(); replaces whatever was at path
+    bool begin(const char* path, const GameSimulation& sim) {
+        close();
+        file = std::fopen(path, "wb");
+        if (!file) return false;
+        used = 0;
+        lastTick = sim.getTicks();
+        for (int i = 0; i < 4; ++i) put(ReplayFormat::magic[i]);
+        put(ReplayFormat::version);
+        put(static_cast<unsigned char>(sim.getLevel()));
+        putVarint(sim.getSeed());
+        putVarint(static_cast<std::uint64_t>(sim.getBoardCols()));
+        putVarint(static_cast<std::uint64_t>(sim.getBoardRows()));
+        return true;
+    }
+
+    // Record a steer at the sim's current tick, i.e. before the next step()
+    void steer(const GameSimulation& sim, GameSimulation::Action action) {
+        static const int dx[] = { 0, 0, -1, 1 };
+        static const int dy[] = { -1, 1, 0, 0 };
+        if (!file || action == GameSimulation::Action::None) return;
+        unsigned code = static_cast<unsigned>(action) - 1;
+        // Steering the way the snake already goes changes nothing, so a bot
+        // that names a direction every tick only costs bytes when it turns
+        Position direction = sim.getSnake().getDirection();
+        if (direction.x == dx[code] && direction.y == dy[code]) return;
+        putEvent(sim.getTicks(), code);
+    }
+
+    // Writes the end marker and summary and closes the file
+    void finish(const GameSimulation& sim) {
+        if (!file) return;
+        putEvent(sim.getTicks(), ReplayFormat::endCode);
+        putVarint(static_cast<std::uint64_t>(sim.getScore()));
+        putVarint(static_cast<std::uint64_t>(sim.getAppleCount()));
+        put(static_cast<unsigned char>(sim.getOutcome()));
+        close();
+    }
+
+    // Without finish() the file ends after the last event, which still plays
+    void close() {
+        if (!file) return;
+        flush();
+        std::fclose(file);
+        file = nullptr;
+    }
+};
+
+class ReplayReader {
+private:
+    std::FILE* file;
+    unsigned char buffer[ReplayFormat::bufferSize];
+    size_t position;
+    size_t available;
+
+    GameSimulation::Level level;
+    std::uint64_t seed;
+    int boardCols;
+    int boardRows;
+
+    bool pending; // An event has been decoded and waits for its tick
+    unsigned long long nextTick;
+    GameSimulation::Action nextAction;
+
+    bool ended; // Reached the end marker or the end of the data
+    bool complete; // The end marker and summary were read
+    unsigned long long endTick;
+    int finalScore;
+    int finalApples;
+    GameSimulation::Outcome finalOutcome;
+
+    bool get(unsigned char& byte) {
+        if (position == available) {
+            if (!file) return false;
+            available = std::fread(buffer, 1, ReplayFormat::bufferSize, file);
+            position = 0;
+            if (available == 0) return false;
+        }
+        byte = buffer[position++];
+        return true;
+    }
+
+    bool getVarint(std::uint64_t& value) {
+        value = 0;
+        unsigned char byte;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (!get(byte)) return false;
+            value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) return true;
+        }
+        return false;
+    }
+
+    void readNext() {
+        pending = false;
+        if (ended) return;
+        std::uint64_t word;
+        if (!getVarint(word)) {
+            ended = true;
+            return;
+        }
+        unsigned code = static_cast<unsigned>(word & 7);
+        unsigned long long tick = nextTick + (word >> 3);
+        if (code == ReplayFormat::endCode) {
+            ended = true;
+            endTick = tick;
+            std::uint64_t score, apples;
+            unsigned char outcome;
+            if (getVarint(score) && getVarint(apples) && get(outcome)) {
+                complete = true;
+                finalScore = static_cast<int>(score);
+                finalApples = static_cast<int>(apples);
+                finalOutcome = static_cast<GameSimulation::Outcome>(outcome);
+            }
+            return;
+        }
+        if (code > 3) {
+            ended = true;
+            return;
+        }
+        nextTick = tick;
+        nextAction = static_cast<GameSimulation::Action>(code + 1);
+        pending = true;
+    }
+
+public:
+    ReplayReader()
+        : file(nullptr), position(0), available(0), level(GameSimulation::Level::Level1), seed(0),
+          boardCols(GameSimulation::startCols), boardRows(GameSimulation::startRows),
+          pending(false), nextTick(0), nextAction(GameSimulation::Action::None), ended(true),
+          complete(false), endTick(0), finalScore(0), finalApples(0),
+          finalOutcome(GameSimulation::Outcome::Running) {}
+    ~ReplayReader() { close(); }
+
+    bool open(const char* path) {
+        close();
+        file = std::fopen(path, "rb");
+        if (!file) return false;
+        return rewind();
+    }
+
+    // Back to the first event, for watching the same replay again
+    bool rewind() {
+        if (!file) return false;
+        std::fseek(file, 0, SEEK_SET);
+        position = available = 0;
+        pending = complete = false;
+        ended = true;
+        nextTick = endTick = 0;
+
+        unsigned char header[6];
+        for (int i = 0; i < 6; ++i) {
+            if (!get(header[i])) return false;
+        }
+        for (int i = 0; i < 4; ++i) {
+            if (header[i] != ReplayFormat::magic[i]) return false;
+        }
+        if (header[4] < 1 || header[4] > ReplayFormat::version || header[5] > 2) return false;
+        level = static_cast<GameSimulation::Level>(header[5]);
+        if (!getVarint(seed)) return false;
+        boardCols = GameSimulation::startCols;
+        boardRows = GameSimulation::startRows;
+        if (header[4] >= 2) {
+            std::uint64_t readCols, readRows;
+            if (!getVarint(readCols) || !getVarint(readRows)) return false;
+            boardCols = static_cast<int>(readCols);
+            boardRows = static_cast<int>(readRows);
+        }
+
+        ended = false;
+        readNext();
+        return true;
+    }
+
+    void close() {
+        if (file) std::fclose(file);
+        file = nullptr;
+        pending = false;
+        ended = true;
+    }
+
+    GameSimulation::Level getLevel() const { return level; }
+    std::uint64_t getSeed() const { return seed; }
+
+    int getBoardCols() const { return boardCols; }
+    int getBoardRows() const { return boardRows; }
+
+    // Starts sim on the recorded board, level and seed
+    void start(GameSimulation& sim) const {
+        sim.setBoardSize(boardCols, boardRows);
+        sim.reset(level, seed);
+    }
+
+    // Applies every steer recorded before the sim's next step()
+    void apply(GameSimulation& sim) {
+        while (pending && nextTick <= sim.getTicks()) {
+            sim.steer(nextAction);
+            readNext();
+        }
+    }
+
+    // True once the sim has played every recorded tick
+    bool isFinished(const GameSimulation& sim) const {
+        if (sim.isOver()) return true;
+        if (!ended || pending) return false;
+        return !complete || sim.getTicks() >= endTick;
+    }
+
+    bool hasSummary() const { return complete && !pending; }
+    unsigned long long getEndTick() const { return endTick; }
+    int getFinalScore() const { return finalScore; }
+    int getFinalApples() const { return finalApples; }
+    GameSimulation::Outcome getFinalOutcome() const { return finalOutcome; }
+
+    // Whether sim ended where the recording says it did
+    bool matches(const GameSimulation& sim) const {
+        return hasSummary() && sim.getTicks() == endTick && sim.getScore() == finalScore &&
+            sim.getAppleCount() == finalApples && sim.getOutcome() == finalOutcome;
+    }
+};
+
+#endif // REPLAY_H
\ No newline at end of file
@@ -1,40 +1,72 @@
-#pragma once
-
-#include "Level2.h"
-#include "Level3.h"
-
-class ScoringSystem {
-public:
-    enum class Level { Level1, Level2, Level3 };
-
-    ScoringSystem(Level level) : currentLevel(level) {}
-
-    int getSmallAppleScore() const {
-        switch (currentLevel) {
-        case Level::Level1:
-            return 1;
-        case Level::Level2:
-            return 2;
-        case Level::Level3:
-            return 3;
-        default:
-            return 0;
-        }
-    }
-
-    int getBigAppleScore() const {
-        switch (currentLevel) {
-        case Level::Level1:
-            return 2;
-        case Level::Level2:
-            return 4;
-        case Level::Level3:
-            return 6; // Assuming a logical progression (e.g., double the small apple score)
-        default:
-            return 0;
-        }
-    }
-
-private:
-    Level currentLevel;
+#pragma once
+
+#include "LevelTraits.h"
+#include "LevelDefinition.h"
+
+// Per-level rules. Kept free of SFML so the headless simulation can use it.
+// The values come from LevelTraits, or from a level file, copied once when
+// the rules are made, so the getters are plain loads.
+class ScoringSystem {
+public:
+    enum class Level { Level1, Level2, Level3 };
+
+    ScoringSystem(Level level) : currentLevel(level) {
+        switch (level) {
+        case Level::Level2: load<2>(); break;
+        case Level::Level3: load<3>(); break;
+        default: load<1>(); break;
+        }
+    }
+
+    // A loaded level plays as its base level everywhere the level is shown
+    explicit ScoringSystem(const LevelDefinition& level)
+        : currentLevel(level.baseLevel == 3 ? Level::Level3 : level.baseLevel == 2 ? Level::Level2 : Level::Level1),
+          smallAppleScore(level.smallAppleScore), bigAppleScore(level.bigAppleScore), moveInterval(level.moveInterval),
+          bombs(level.hasBombs), shrinkingWalls(level.hasShrinkingWalls), blueAppleInterval(level.blueAppleInterval),
+          blueAppleVisibleDuration(level.blueAppleVisibleDuration), bombInterval(level.bombInterval),
+          bombVisibleDuration(level.bombVisibleDuration), wallShrinkInterval(level.wallShrinkInterval),
+          palette(level.palette) {}
+
+    int getSmallAppleScore() const { return smallAppleScore; }
+    int getBigAppleScore() const { return bigAppleScore; }
+    float getMoveInterval() const { return moveInterval; }
+    bool hasBombs() const { return bombs; }
+    bool hasShrinkingWalls() const { return shrinkingWalls; }
+    float getBlueAppleInterval() const { return blueAppleInterval; }
+    float getBlueAppleVisibleDuration() const { return blueAppleVisibleDuration; }
+    float getBombInterval() const { return bombInterval; }
+    float getBombVisibleDuration() const { return bombVisibleDuration; }
+    float getWallShrinkInterval() const { return wallShrinkInterval; }
+    const LevelPalette& getPalette() const { return palette; }
+
+    Level getLevel() const { return currentLevel; }
+
+private:
+    Level currentLevel;
+    int smallAppleScore;
+    int bigAppleScore;
+    float moveInterval;
+    bool bombs;
+    bool shrinkingWalls;
+    float blueAppleInterval;
+    float blueAppleVisibleDuration;
+    float bombInterval;
+    float bombVisibleDuration;
+    float wallShrinkInterval;
+    LevelPalette palette;
+
+    template <int N>
+    void load() {
+        smallAppleScore = LevelTraits<N>::smallAppleScore;
+        bigAppleScore = LevelTraits<N>::bigAppleScore;
+        moveInterval = LevelTraits<N>::moveInterval;
+        bombs = LevelTraits<N>::hasBombs;
+        shrinkingWalls = LevelTraits<N>::hasShrinkingWalls;
+        blueAppleInterval = LevelTraits<N>::blueAppleInterval;
+        blueAppleVisibleDuration = LevelTraits<N>::blueAppleVisibleDuration;
+        bombInterval = LevelTraits<N>::bombInterval;
+        bombVisibleDuration = LevelTraits<N>::bombVisibleDuration;
+        wallShrinkInterval = LevelTraits<N>::wallShrinkInterval;
+        palette = LevelTraits<N>::palette();
+    }
 };
\ No newline at end of file
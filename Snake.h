@@ -0,0 +1,92 @@
+#ifndef SNAKE_H
+#define SNAKE_H
+
+#include "Position.h"
+#include "SnakeBody.h"
+#include "OccupancyGrid.h"
+
+class Snake {
+private:
+    SnakeBody body;
+    OccupancyGrid occupancy;
+    Position direction;
+    Position previousTail; // Where the tail was before the last update()
+    bool growing;
+
+    void pushHead(const Position& position) {
+        body.pushFront(position);
+        occupancy.add(position);
+    }
+
+public:
+    // Room for every cell plus the two extra segments a blue apple can add.
+    // A level's walls, if any, go into the occupancy grid before the body.
+    Snake(int cols, int rows, const ObstacleMap* obstacles = nullptr)
+        : body(static_cast<size_t>(cols) * rows + 2), occupancy(cols, rows), direction{ 1, 0 }, growing(false) {
+        if (obstacles) occupancy.setObstacles(*obstacles);
+        pushHead({ 3, 9 });
+        pushHead({ 4, 9 });
+        pushHead({ 5, 9 });
+        previousTail = body.back();
+    }
+
+    void setDirection(int dx, int dy) {
+        if (body.size() > 1 && direction.x == -dx && direction.y == -dy) return;
+        direction = { dx, dy };
+    }
+
+    void update() {
+        Position newHead = body.front();
+        newHead.x += direction.x;
+        newHead.y += direction.y;
+        previousTail = body.back();
+        pushHead(newHead);
+
+        if (!growing) {
+            occupancy.remove(body.back());
+            body.popBack();
+        }
+        else growing = false;
+    }
+
+    // Level 3 wall shrink: pull every segment back inside the new bounds
+    void clampTo(int cols, int rows) {
+        for (auto& segment : body) {
+            if (segment.x >= cols) segment.x = cols - 1;
+            if (segment.y >= rows) segment.y = rows - 1;
+        }
+        previousTail = body.back();
+        occupancy.setBounds(cols, rows);
+        occupancy.clear();
+        for (const auto& segment : body) {
+            occupancy.add(segment);
+        }
+    }
+
+    void grow() { growing = true; }
+    bool isGrowing() const { return growing; }
+
+    Position getHead() const { return body.front(); }
+    Position getDirection() const { return direction; }
+    Position getPreviousTail() const { return previousTail; }
+
+    const SnakeBody& getBody() const { return body; }
+    const OccupancyGrid& getOccupancy() const { return occupancy; }
+
+    // Also true when the head ran into a wall of the level; hitObstacle()
+    // tells the two apart once the game is over anyway
+    bool checkSelfCollision() const {
+        return occupancy.isCrowded(body.front());
+    }
+
+    bool hitObstacle() const {
+        return occupancy.isObstacle(body.front());
+    }
+
+    bool checkWallCollision(int cols, int rows) const {
+        const Position& head = body.front();
+        return head.x < 0 || head.x >= cols || head.y < 0 || head.y >= rows;
+    }
+};
+
+#endif // SNAKE_H
@@ -0,0 +1,416 @@
+#ifndef SNAKEARENA_H
+#define SNAKEARENA_H
+
+#include "GameSimulation.h"
+#include "GameRandom.h"
+#include "Position.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+// Arena size, population and rules; the defaults suit a screen-sized match
+struct ArenaSettings {
+    int cols;
+    int rows;
+    int snakes;            // Including the players
+    int players;           // Snakes 0..players-1 are steered from outside, the rest by the bot
+    int apples;            // Kept on the board at all times
+    int maxLength;         // Segments; growth stops here
+    unsigned respawnTicks; // Wait before a dead snake comes back
+    int botSight;          // How far, in cells, a bot looks for apples
+
+    ArenaSettings()
+        : cols(400), rows(300), snakes(200), players(1), apples(400), maxLength(256), respawnTicks(60), botSight(8) {}
+};
+
+// Many snakes on one board: local players plus simple bots, for the arena
+// mode and for measuring how the core scales. Like GameSimulation there is
+// no SFML here and step() is one tick.
+//
+// Snake state is kept as a structure of arrays, one vector per field indexed
+// by snake id, so each pass of a tick streams through only the fields it
+// needs. Every snake's body is a ring of cell indices in its own fixed
+// slice of one shared buffer, so nothing is allocated after reset(). One
+// grid of 16-bit owners (0 for empty, id + 1 for a snake's segment, or the
+// apple marker) answers every collision and spawn question in one read.
+//
+// A tick runs in fixed passes, each over the snakes in id order: the bots
+// choose their moves against the board as it stood at the start of the
+// tick; every tail that is not growing leaves its cell; then every head
+// moves in. A head entering a cell another head entered this tick kills
+// both, and a head entering any other taken cell, or leaving the board,
+// kills its own snake. The dead are cleared from the grid only after all
+// heads have moved, so who dies never depends on the id order. Random draws
+// come from GameRandom streams consumed in id order, so a seed and the same
+// player input give the same arena anywhere.
+class SnakeArena {
+public:
+    static const int maxBoardSide = 2000;
+    static const int maxSnakes = 0xFFF0; // Owners must fit below the markers
+    static const std::uint16_t emptyCell = 0;
+    static const std::uint16_t appleCell = 0xFFFF;
+
+    enum class Death { HitWall, HitSnake, HeadOn };
+    static const int deathCauses = 3;
+
+private:
+    enum State : unsigned char { Dead, Alive, Dying };
+    enum Stream : std::uint64_t { SpawnStream = 1, AppleStream = 2, BotStream = 3 };
+
+    ArenaSettings settings;
+    int cols;
+    int rows;
+    std::vector<std::uint16_t> owner; // Per cell
+
+    // Per snake, indexed by id
+    std::vector<int> segments; // Ring of cell indices per snake, capacity each
+    std::vector<int> heads;    // Head cell, also in segments; dense for the bots' lookups
+    std::vector<int> headSlot;
+    std::vector<int> length;
+    std::vector<int> growth;   // Segments still to add
+    std::vector<unsigned char> direction; // 0 up, 1 down, 2 left, 3 right
+    std::vector<unsigned char> state;
+    std::vector<int> score;
+    std::vector<int> target;   // Bot: apple cell it is heading for, or -1
+    std::vector<unsigned> respawnTimer;
+    std::vector<int> nextHead; // Cell the head moves into this tick, or -1 off the board
+
+    std::vector<int> dying;    // Ids that died this tick
+    int capacity;              // Ring size, a power of two
+    int capacityMask;
+    GameRandom spawnRng;
+    GameRandom appleRng;
+    GameRandom botRng;
+    int aliveCount;
+    int appleCount;
+    unsigned long long ticks;
+    unsigned long long deaths[deathCauses];
+
+    static int moveX(int move) { static const int dx[] = { 0, 0, -1, 1 }; return dx[move]; }
+    static int moveY(int move) { static const int dy[] = { -1, 1, 0, 0 }; return dy[move]; }
+    static int reverseOf(int move) { return move ^ 1; }
+
+    int slotIndex(int id, int slot) const {
+        return id * capacity + (slot & capacityMask);
+    }
+
+    // Empty or an apple: somewhere a head can go
+    bool isOpen(int x, int y) const {
+        if (x < 0 || x >= cols || y < 0 || y >= rows) return false;
+        std::uint16_t value = owner[y * cols + x];
+        return value == emptyCell || value == appleCell;
+    }
+
+    // Another snake's head is next to the cell, so moving in may be head-on
+    bool isContested(int id, int x, int y) const {
+        for (int move = 0; move < 4; ++move) {
+            int nx = x + moveX(move), ny = y + moveY(move);
+            if (nx < 0 || nx >= cols || ny < 0 || ny >= rows) continue;
+            std::uint16_t value = owner[ny * cols + nx];
+            if (value == emptyCell || value == appleCell || value == id + 1) continue;
+            if (heads[value - 1] == ny * cols + nx) return true;
+        }
+        return false;
+    }
+
+    // Nearest apple within botSight of the head, or -1
+    int findApple(int headX, int headY) const {
+        int sight = settings.botSight;
+        int best = -1;
+        int bestDistance = 0;
+        for (int y = std::max(0, headY - sight); y <= std::min(rows - 1, headY + sight); ++y) {
+            const std::uint16_t* row = &owner[y * cols];
+            for (int x = std::max(0, headX - sight); x <= std::min(cols - 1, headX + sight); ++x) {
+                if (row[x] != appleCell) continue;
+                int distance = std::abs(x - headX) + std::abs(y - headY);
+                if (best < 0 || distance < bestDistance) {
+                    best = y * cols + x;
+                    bestDistance = distance;
+                }
+            }
+        }
+        return best;
+    }
+
+    // The bot: head for the nearest apple it can see by the open move that
+    // closes the most distance, preferring straight on ties; with no apple in
+    // sight, wander mostly straight. Cells another head could also enter are
+    // only taken when nothing else is open, and with no open move at all it
+    // keeps going. A bot with nothing in sight looks again every fourth tick,
+    // staggered by id, which keeps the search off most bots' ticks.
+    void think(int id) {
+        int head = heads[id];
+        int headX = head % cols, headY = head / cols;
+        if (target[id] >= 0 && owner[target[id]] != appleCell) target[id] = -1;
+        if (target[id] < 0 && (ticks + id) % 4 == 0) target[id] = findApple(headX, headY);
+
+        int current = direction[id];
+        int open[4];
+        int openCount = 0;
+        int contested[4];
+        int contestedCount = 0;
+        for (int move = 0; move < 4; ++move) {
+            if (move == reverseOf(current)) continue;
+            int x = headX + moveX(move), y = headY + moveY(move);
+            if (!isOpen(x, y)) continue;
+            if (isContested(id, x, y)) contested[contestedCount++] = move;
+            else open[openCount++] = move;
+        }
+        if (openCount == 0) {
+            std::copy(contested, contested + contestedCount, open);
+            openCount = contestedCount;
+        }
+        if (openCount == 0) return;
+
+        if (target[id] >= 0) {
+            int targetX = target[id] % cols, targetY = target[id] / cols;
+            int best = -1;
+            int bestCost = 0;
+            for (int i = 0; i < openCount; ++i) {
+                int move = open[i];
+                int cost = 2 * (std::abs(headX + moveX(move) - targetX) + std::abs(headY + moveY(move) - targetY)) +
+                    (move == current ? 0 : 1);
+                if (best < 0 || cost < bestCost) {
+                    best = move;
+                    bestCost = cost;
+                }
+            }
+            direction[id] = static_cast<unsigned char>(best);
+            return;
+        }
+        bool straightOpen = std::find(open, open + openCount, current) != open + openCount;
+        if (straightOpen && botRng.nextBelow(16) != 0) return;
+        direction[id] = static_cast<unsigned char>(open[botRng.nextBelow(static_cast<std::uint32_t>(openCount))]);
+    }
+
+    void kill(int id, Death cause) {
+        if (state[id] == Dying) return;
+        state[id] = Dying;
+        dying.push_back(id);
+        ++deaths[static_cast<int>(cause)];
+    }
+
+    // Three segments in a line with a free cell ahead; false if the spot
+    // drawn was taken, to be tried again next tick
+    bool trySpawn(int id) {
+        int move = static_cast<int>(spawnRng.nextBelow(4));
+        int x = 2 + static_cast<int>(spawnRng.nextBelow(static_cast<std::uint32_t>(cols - 4)));
+        int y = 2 + static_cast<int>(spawnRng.nextBelow(static_cast<std::uint32_t>(rows - 4)));
+        for (int i = -2; i <= 1; ++i) {
+            if (owner[(y + i * moveY(move)) * cols + x + i * moveX(move)] != emptyCell) return false;
+        }
+        headSlot[id] = 2;
+        for (int i = 0; i < 3; ++i) {
+            int cell = (y + (i - 2) * moveY(move)) * cols + x + (i - 2) * moveX(move);
+            segments[slotIndex(id, i)] = cell;
+            owner[cell] = static_cast<std::uint16_t>(id + 1);
+        }
+        heads[id] = y * cols + x;
+        length[id] = 3;
+        growth[id] = 0;
+        direction[id] = static_cast<unsigned char>(move);
+        state[id] = Alive;
+        score[id] = 0;
+        target[id] = -1;
+        ++aliveCount;
+        return true;
+    }
+
+    void placeApples() {
+        // A few draws per missing apple; a crowded board catches up later
+        for (int attempts = 0; appleCount < settings.apples && attempts < 4 * settings.apples; ++attempts) {
+            int cell = static_cast<int>(appleRng.nextBelow(static_cast<std::uint32_t>(cols * rows)));
+            if (owner[cell] != emptyCell) continue;
+            owner[cell] = appleCell;
+            ++appleCount;
+        }
+    }
+
+public:
+    SnakeArena() : cols(0), rows(0), capacity(0), capacityMask(0), aliveCount(0), appleCount(0), ticks(0) {
+        std::fill(deaths, deaths + deathCauses, 0ULL);
+    }
+
+    // Sizes are clamped to what the grid can hold. Buffers are reused when
+    // the new arena fits in the old one's.
+    void reset(const ArenaSettings& newSettings, std::uint64_t seed) {
+        settings = newSettings;
+        settings.cols = std::min(std::max(settings.cols, static_cast<int>(GameSimulation::startCols)), static_cast<int>(maxBoardSide));
+        settings.rows = std::min(std::max(settings.rows, static_cast<int>(GameSimulation::startRows)), static_cast<int>(maxBoardSide));
+        settings.snakes = std::min(std::max(settings.snakes, 1), static_cast<int>(maxSnakes));
+        settings.players = std::min(std::max(settings.players, 0), settings.snakes);
+        settings.maxLength = std::max(settings.maxLength, 3);
+        cols = settings.cols;
+        rows = settings.rows;
+        capacity = 4;
+        while (capacity < settings.maxLength) capacity *= 2;
+        capacityMask = capacity - 1;
+
+        size_t count = static_cast<size_t>(settings.snakes);
+        owner.assign(static_cast<size_t>(cols) * rows, static_cast<std::uint16_t>(emptyCell));
+        segments.assign(count * capacity, 0);
+        heads.assign(count, 0);
+        headSlot.assign(count, 0);
+        length.assign(count, 0);
+        growth.assign(count, 0);
+        direction.assign(count, 0);
+        state.assign(count, Dead);
+        score.assign(count, 0);
+        target.assign(count, -1);
+        respawnTimer.assign(count, 0);
+        nextHead.assign(count, -1);
+        dying.clear();
+        dying.reserve(count);
+
+        spawnRng.seed(seed, SpawnStream);
+        appleRng.seed(seed, AppleStream);
+        botRng.seed(seed, BotStream);
+        aliveCount = 0;
+        appleCount = 0;
+        ticks = 0;
+        std::fill(deaths, deaths + deathCauses, 0ULL);
+        for (int id = 0; id < settings.snakes; ++id) trySpawn(id);
+        placeApples();
+    }
+
+    // Player input, applied immediately; like Snake::setDirection the snake
+    // refuses to reverse
+    void steer(int id, GameSimulation::Action action) {
+        if (id < 0 || id >= settings.players || state[id] != Alive) return;
+        int move;
+        switch (action) {
+        case GameSimulation::Action::Up: move = 0; break;
+        case GameSimulation::Action::Down: move = 1; break;
+        case GameSimulation::Action::Left: move = 2; break;
+        case GameSimulation::Action::Right: move = 3; break;
+        default: return;
+        }
+        if (move != reverseOf(direction[id])) direction[id] = static_cast<unsigned char>(move);
+    }
+
+    void step() {
+        ++ticks;
+        const int snakes = settings.snakes;
+
+        for (int id = settings.players; id < snakes; ++id) {
+            if (state[id] == Alive) think(id);
+        }
+
+        // Tails first, so a head may follow a tail into the cell it leaves
+        for (int id = 0; id < snakes; ++id) {
+            if (state[id] != Alive) continue;
+            int head = heads[id];
+            int x = head % cols + moveX(direction[id]);
+            int y = head / cols + moveY(direction[id]);
+            nextHead[id] = x >= 0 && x < cols && y >= 0 && y < rows ? y * cols + x : -1;
+            if (growth[id] > 0) {
+                --growth[id];
+            }
+            else {
+                owner[segments[slotIndex(id, headSlot[id] - length[id] + 1)]] = emptyCell;
+                --length[id];
+            }
+        }
+
+        for (int id = 0; id < snakes; ++id) {
+            if (state[id] != Alive) continue;
+            int cell = nextHead[id];
+            if (cell < 0) {
+                kill(id, Death::HitWall);
+                continue;
+            }
+            std::uint16_t value = owner[cell];
+            if (value != emptyCell && value != appleCell) {
+                // An earlier snake's head moved in here this tick: both die.
+                // One that was killed this tick never left its old head, so
+                // it counts only if its head is now on this cell.
+                int other = value - 1;
+                if (other < id && nextHead[other] == cell && heads[other] == cell) {
+                    kill(other, Death::HeadOn);
+                    kill(id, Death::HeadOn);
+                }
+                else {
+                    kill(id, Death::HitSnake);
+                }
+                continue;
+            }
+            if (value == appleCell) {
+                --appleCount;
+                ++score[id];
+                if (length[id] + growth[id] < settings.maxLength) ++growth[id];
+            }
+            owner[cell] = static_cast<std::uint16_t>(id + 1);
+            headSlot[id] = (headSlot[id] + 1) & capacityMask;
+            segments[slotIndex(id, headSlot[id])] = cell;
+            heads[id] = cell;
+            ++length[id];
+        }
+
+        // Only now do the dead leave the board
+        for (int id : dying) {
+            for (int i = 0; i < length[id]; ++i) {
+                int cell = segments[slotIndex(id, headSlot[id] - i)];
+                if (owner[cell] == id + 1) owner[cell] = emptyCell;
+            }
+            state[id] = Dead;
+            length[id] = 0;
+            respawnTimer[id] = settings.respawnTicks;
+            --aliveCount;
+        }
+        dying.clear();
+
+        placeApples();
+        if (aliveCount < snakes) {
+            for (int id = 0; id < snakes; ++id) {
+                if (state[id] != Dead) continue;
+                if (respawnTimer[id] > 0) --respawnTimer[id];
+                else trySpawn(id);
+            }
+        }
+    }
+
+    // Folds every snake and the whole grid into one number, to check that
+    // two runs of the same seed and input ended up in the same place
+    std::uint64_t checksum() const {
+        std::uint64_t hash = 14695981039346656037ULL;
+        auto mix = [&hash](std::uint64_t value) {
+            hash ^= value;
+            hash *= 1099511628211ULL;
+        };
+        for (int id = 0; id < settings.snakes; ++id) {
+            mix(state[id]);
+            mix(static_cast<std::uint64_t>(length[id]));
+            mix(static_cast<std::uint64_t>(score[id]));
+            if (state[id] == Alive) mix(static_cast<std::uint64_t>(heads[id]));
+        }
+        for (std::uint16_t value : owner) mix(value);
+        return hash;
+    }
+
+    std::uint16_t ownerAt(const Position& cell) const {
+        if (cell.x < 0 || cell.x >= cols || cell.y < 0 || cell.y >= rows) return emptyCell;
+        return owner[cell.y * cols + cell.x];
+    }
+
+    bool isAlive(int id) const { return state[id] == Alive; }
+    Position getHead(int id) const { return Position{ heads[id] % cols, heads[id] / cols }; }
+    // fromHead 0 is the head; only meaningful below getLength(id)
+    Position getSegment(int id, int fromHead) const {
+        int cell = segments[slotIndex(id, headSlot[id] - fromHead)];
+        return Position{ cell % cols, cell / cols };
+    }
+    int getLength(int id) const { return length[id]; }
+    int getScore(int id) const { return score[id]; }
+    int getCols() const { return cols; }
+    int getRows() const { return rows; }
+    int getSnakeCount() const { return settings.snakes; }
+    int getPlayerCount() const { return settings.players; }
+    int getAliveCount() const { return aliveCount; }
+    int getAppleCount() const { return appleCount; }
+    unsigned long long getTicks() const { return ticks; }
+    unsigned long long getDeaths(Death cause) const { return deaths[static_cast<int>(cause)]; }
+    const ArenaSettings& getSettings() const { return settings; }
+};
+
+#endif // SNAKEARENA_H
\ No newline at end of file
@@ -0,0 +1,101 @@
+#ifndef SNAKEBODY_H
+#define SNAKEBODY_H
+
+#include "Position.h"
+#include <vector>
+#include <iterator>
+#include <cstddef>
+
+// Circular buffer holding the snake segments in head-to-tail order.
+// Pushing a new head and popping the tail are both O(1), so moving the
+// snake no longer shifts every segment the way vector::insert(begin()) did.
+class SnakeBody {
+private:
+    std::vector<Position> slots;
+    size_t headSlot;
+    size_t count;
+
+    size_t slotOf(size_t index) const {
+        size_t slot = headSlot + index;
+        return slot >= slots.size() ? slot - slots.size() : slot;
+    }
+
+    // Only reached if a caller outgrows the capacity it asked for
+    void grow() {
+        std::vector<Position> larger(slots.empty() ? 4 : slots.size() * 2);
+        for (size_t i = 0; i < count; ++i) {
+            larger[i] = slots[slotOf(i)];
+        }
+        slots.swap(larger);
+        headSlot = 0;
+    }
+
+public:
+    template <typename Owner, typename Value>
+    class Iterator {
+    private:
+        Owner* body;
+        size_t index;
+
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef Position value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef Value* pointer;
+        typedef Value& reference;
+
+        Iterator(Owner* body, size_t index) : body(body), index(index) {}
+
+        reference operator*() const { return (*body)[index]; }
+        pointer operator->() const { return &(*body)[index]; }
+        Iterator& operator++() { ++index; return *this; }
+        Iterator operator++(int) { Iterator old = *this; ++index; return old; }
+        bool operator==(const Iterator& other) const { return index == other.index; }
+        bool operator!=(const Iterator& other) const { return index != other.index; }
+    };
+
+    typedef Iterator<SnakeBody, Position> iterator;
+    typedef Iterator<const SnakeBody, const Position> const_iterator;
+
+    SnakeBody() : headSlot(0), count(0) {}
+    explicit SnakeBody(size_t capacity) : slots(capacity), headSlot(0), count(0) {}
+
+    void pushFront(const Position& position) {
+        if (count == slots.size()) grow();
+        headSlot = (headSlot == 0 ? slots.size() : headSlot) - 1;
+        slots[headSlot] = position;
+        ++count;
+    }
+
+    void popBack() {
+        if (count > 0) --count;
+    }
+
+    void clear() {
+        headSlot = 0;
+        count = 0;
+    }
+
+    Position& front() { return slots[headSlot]; }
+    const Position& front() const { return slots[headSlot]; }
+    Position& back() { return slots[slotOf(count - 1)]; }
+    const Position& back() const { return slots[slotOf(count - 1)]; }
+
+    Position& operator[](size_t index) { return slots[slotOf(index)]; }
+    const Position& operator[](size_t index) const { return slots[slotOf(index)]; }
+
+    // Storage slot of the head; segment i sits in slot (headSlot + i) % capacity.
+    // Lets renderers mirror the buffer and touch only the slots that changed.
+    size_t getHeadSlot() const { return headSlot; }
+
+    size_t size() const { return count; }
+    size_t capacity() const { return slots.size(); }
+    bool empty() const { return count == 0; }
+
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, count); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, count); }
+};
+
+#endif // SNAKEBODY_H